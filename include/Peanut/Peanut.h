@@ -28,9 +28,18 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/dyn_matrix.h>
+#include <Peanut/impl/map.h>
 #include <Peanut/impl/matrix.h>
+#include <Peanut/impl/matrix_batch.h>
 #include <Peanut/impl/matrix_binary_op.h>
+#include <Peanut/impl/matrix_eval.h>
+#include <Peanut/impl/matrix_eval_all.h>
+#include <Peanut/impl/matrix_reduction.h>
+#include <Peanut/impl/matrix_storage.h>
 #include <Peanut/impl/matrix_type_traits.h>
 #include <Peanut/impl/matrix_unary_op.h>
+#include <Peanut/impl/packed_matrix.h>
+#include <Peanut/impl/packet.h>
 
 // Dependencies headers
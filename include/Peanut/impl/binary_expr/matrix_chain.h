@@ -0,0 +1,165 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+// Standard headers
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/binary_expr/matrix_mult.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Compile-time solver of matrix-chain ordering problem, which
+     *        finds the parenthesization of a product of matrices with the
+     *        least number of scalar multiplications by dynamic programming.
+     *        See https://en.wikipedia.org/wiki/Matrix_chain_multiplication.
+     * @details The i'th operand is a \p D[i] by \p D[i+1] matrix. On ties,
+     *          the split closest to the left-to-right order is chosen.
+     * @tparam D Dimensions of the operands.
+     */
+    template<Index... D>
+        requires (sizeof...(D) >= 3)
+    struct MatrixChain {
+        static constexpr std::size_t N = sizeof...(D) - 1;
+
+        struct Table {
+            // Least cost and split point of the product of operands i..j
+            std::array<std::array<std::size_t, N>, N> cost{};
+            std::array<std::array<std::size_t, N>, N> split{};
+        };
+
+        static constexpr Table table = [](){
+            constexpr std::array<std::size_t, N + 1> d{static_cast<std::size_t>(D)...};
+            Table t{};
+            for (std::size_t len = 1; len < N; len++) {
+                for (std::size_t i = 0; i + len < N; i++) {
+                    const std::size_t j = i + len;
+                    t.cost[i][j] = std::numeric_limits<std::size_t>::max();
+                    for (std::size_t k = i; k < j; k++) {
+                        const std::size_t c = t.cost[i][k] + t.cost[k + 1][j] + d[i] * d[k + 1] * d[j + 1];
+                        if (c <= t.cost[i][j]) {
+                            t.cost[i][j] = c;
+                            t.split[i][j] = k;
+                        }
+                    }
+                }
+            }
+            return t;
+        }();
+
+        /**
+         * @brief Product of operands \p i .. \p j is split into \p i .. k
+         *        and k+1 .. \p j in the optimal order.
+         * @return k
+         */
+        static constexpr std::size_t split(std::size_t i, std::size_t j) {
+            return table.split[i][j];
+        }
+
+        /**
+         * @brief Number of scalar multiplications of the product of
+         *        operands \p i .. \p j in the optimal order.
+         */
+        static constexpr std::size_t cost(std::size_t i, std::size_t j) {
+            return table.cost[i][j];
+        }
+    };
+
+    /**
+     * @brief `MatrixChain` of given fixed-size Peanut matrix expressions.
+     */
+    template<typename... E>
+    using matrix_chain_t = MatrixChain<E::Row..., std::tuple_element_t<sizeof...(E) - 1, std::tuple<E...>>::Col>;
+
+    /**
+     * @brief Build nested `MatrixMult` of operands \p I .. \p J in the
+     *        order given by \p Chain .
+     * @param x Tuple of references of operands.
+     * @return Operand itself if \p I == \p J , `MatrixMult` instance otherwise.
+     */
+    template<typename Chain, std::size_t I, std::size_t J, typename Tuple>
+    INLINE decltype(auto) chain_product(const Tuple &x) {
+        if constexpr (I == J) {
+            return std::get<I>(x);
+        }
+        else {
+            constexpr std::size_t K = Chain::split(I, J);
+            return chain_product<Chain, I, K>(x) * chain_product<Chain, K + 1, J>(x);
+        }
+    }
+}
+
+namespace Peanut {
+
+    /**
+     * @brief Product of fixed-size matrices in the order which minimizes
+     *        the number of scalar multiplications, solved at compile-time.
+     *        See `Impl::MatrixChain`.
+     *
+     *     // Evaluated as A * (B * v)
+     *     auto prod = Chain(A, B, v);
+     *
+     * @tparam E Matrix expression types.
+     * @return Nested `Impl::MatrixMult` instance.
+     */
+    template<typename... E>
+        requires (sizeof...(E) >= 2) && (is_fixed_size_v<E> && ...)
+    auto Chain(const MatrixExpr<E> &... x) {
+        using Order = Impl::matrix_chain_t<E...>;
+        return Impl::chain_product<Order, 0, sizeof...(E) - 1>(std::tuple<const E &...>(static_cast<const E &>(x)...));
+    }
+
+    /**
+     * @brief Specialization of `operator*()` for `(A * B) * C` of fixed-size
+     *        matrices, which is rewritten as `A * (B * C)` if it needs less
+     *        scalar multiplications (e.g., `A * B * v` for a vector `v`).
+     *        It is only applied if `A` and `B` are leaves (See `is_leaf`),
+     *        as `A * B` is not evaluated yet.
+     * @tparam E1 Left hand side matrix expression type of `A * B`.
+     * @tparam E2 Right hand side matrix expression type of `A * B`.
+     * @tparam E3 Right hand side matrix expression type.
+     * @return Constructed `Impl::MatrixMult` instance in the cheaper order.
+     */
+    template<typename E1, typename E2, typename E3>
+        requires is_leaf_v<E1> && is_leaf_v<E2> && (!is_packed_v<E3>) &&
+                 is_fixed_size_v<E1> && is_fixed_size_v<E2> && is_fixed_size_v<E3> && (E2::Col == E3::Row)
+    auto operator*(const Impl::MatrixMult<E1, E2> &x, const MatrixExpr<E3> &y) {
+        const E3 &z = static_cast<const E3 &>(y);
+        if constexpr (Impl::matrix_chain_t<E1, E2, E3>::split(0, 2) == 0) {
+            return x.x * (x.y * z);
+        }
+        else {
+            return Impl::MatrixMult<Impl::MatrixMult<E1, E2>, E3>(x, z);
+        }
+    }
+}
@@ -24,19 +24,42 @@
 #pragma once
 
 // Standard headers
+#include <cmath>
 #include <stdexcept>
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+#include <Peanut/impl/unary_expr/shared.h>
 
 // Dependencies headers
 
 namespace Peanut::Impl {
 
+    /**
+     * @brief Check if the reciprocal of \p y is exactly representable in
+     *        `Float`, i.e., \p y is a power of two whose reciprocal is not
+     *        rounded. Multiplication by such reciprocal gives the same result
+     *        as division by \p y.
+     * @param y Non-zero divisor.
+     * @return True if the reciprocal of \p y is exact.
+     */
+    INLINE bool is_exact_reciprocal(Float y) {
+        int exp;
+        const Float inv = static_cast<Float>(1) / y;
+        return std::abs(std::frexp(y, &exp)) == static_cast<Float>(0.5) &&
+               std::isnormal(inv) && std::abs(std::frexp(inv, &exp)) == static_cast<Float>(0.5);
+    }
+
     /**
      * @brief Expression class which represents `operator/()`. It represents
      *        `Float` type matrix while evaluation always.
+     * @details Whether the reciprocal of \p y is exact is checked once on
+     *          construction. If it is (e.g., A / 2), elements are multiplied
+     *          by the reciprocal instead of being divided, which gives the
+     *          same result. See `is_exact_reciprocal()`.
      * @tparam E Left hand side matrix expression type.
      * @tparam T Right hand side scalar type.
      */
@@ -48,26 +71,76 @@ namespace Peanut::Impl {
             if (is_zero(y)) {
                 throw std::invalid_argument("Divide by zero");
             }
+            exact = is_exact_reciprocal(static_cast<Float>(y));
+            inv = static_cast<Float>(1) / static_cast<Float>(y);
         }
 
         // Static polymorphism implementation of MatrixExpr
         INLINE Float operator()(Index r, Index c) const {
-            return static_cast<Type>(x(r, c)) / static_cast<Float>(y);
+            return divide(static_cast<Type>(x(r, c)));
         }
 
         static constexpr Index Row = E::Row;
         static constexpr Index Col = E::Col;
+        static constexpr bool Linear = is_linear_v<E>;
+        static constexpr Layout StorageOrder = storage_order_v<E>;
+        static constexpr bool Vectorizable = is_vectorizable_v<E> && is_packet_castable_v<typename E::Type, Float> &&
+                                             has_packet_div_v<Float>;
+        static constexpr bool Epilogue = has_epilogue_v<E>;
+        static constexpr std::size_t Cost = cost_v<E> + 1;
 
-        INLINE void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = static_cast<Type>(x(i, j)) / static_cast<Float>(y);
-                }
-            }
+        // Flat index access, available if the expression is linearly accessible
+        INLINE Float coeff(Index i) const requires Linear {
+            return divide(static_cast<Type>(x.coeff(i)));
+        }
+
+        // SIMD packet access, available if the expression is vectorizable
+        template <bool Aligned = false>
+        INLINE Packet<Type> packet(Index i) const requires Vectorizable {
+            const Packet<Type> p = packet_cast<Float>(x.template packet<Aligned>(i));
+            return exact ? p * Packet<Float>::set1(inv) : p / Packet<Float>::set1(static_cast<Float>(y));
+        }
+
+        // Element given the product element at the same position, available
+        // if the expression has a product to be fused (See `has_epilogue`)
+        template <typename P>
+        INLINE Float epilogue(Index r, Index c, const P &p) const requires Epilogue {
+            return divide(static_cast<Type>(x.epilogue(r, c, p)));
+        }
+
+        INLINE const auto &product() const requires Epilogue {
+            return x.product();
         }
 
-        const E &x;
+        INLINE Index rows() const {
+            return x.rows();
+        }
+
+        INLINE Index cols() const {
+            return x.cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixDivScalar>
+        INLINE void eval(M &_result) const {
+            evaluate(_result, *this);
+        }
+
+        nested_t<E> x;
         T y;
+        // Reciprocal of y, which is used instead of y if `exact` is true
+        Float inv;
+        bool exact;
+
+    private:
+        INLINE Float divide(Float v) const {
+            return exact ? v * inv : v / static_cast<Float>(y);
+        }
     };
 }
 
@@ -81,7 +154,8 @@ namespace Peanut {
      */
     template<typename E, typename T>
         requires is_matrix_v<E> && std::is_arithmetic_v<T>
-    Impl::MatrixDivScalar<E, T> operator/(const MatrixExpr<E> &x, const T &y) {
-        return Impl::MatrixDivScalar<E, T>(static_cast<const E &>(x), y);
+    auto operator/(const MatrixExpr<E> &x, const T &y) {
+        decltype(auto) e = Impl::elementwise_operand(static_cast<const E &>(x));
+        return Impl::MatrixDivScalar<std::remove_cvref_t<decltype(e)>, T>(e, y);
     }
 }
@@ -24,10 +24,17 @@
 #pragma once
 
 // Standard headers
+#include <array>
+#include <type_traits>
+#include <vector>
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/unary_expr/shared.h>
+#include <Peanut/impl/unary_expr/negation.h>
+#include <Peanut/impl/unary_expr/transpose.h>
 
 // Dependencies headers
 
@@ -35,48 +42,227 @@ namespace Peanut::Impl {
 
     /**
      * @brief Expression class which represents `operator*()`.
-     * @details Note that `MatrixMult` evaluates its operands internally
-     *          for the performance issues.
+     * @details Leaf operands (See `is_leaf`) are referred as they are, so
+     *          a product of plain matrices does not copy any element. Other
+     *          operands are evaluated internally during construction if it is
+     *          costly to compute their elements lazily (See `is_costly`),
+     *          since each of them is read as many times as the size of the
+     *          other side (e.g., `A * (B + C)` of 4x4 matrices adds on the
+     *          fly, while the one of 64x64 matrices evaluates `B + C` first).
+     *          Transposes of leaves (See `is_transposed_leaf`) are referred as
+     *          well, and products with them are evaluated by kernels which
+     *          read the original storage in its order (e.g., dot products of
+     *          rows for `A * T(B)`), instead of building a transposed copy.
      * @tparam E1 Left hand side matrix expression type.
      * @tparam E2 Right hand side matrix expression type.
      */
     template<typename E1, typename E2>
-        requires(E1::Col == E2::Row)
+        requires(E1::Col == E2::Row || E1::Col == Dynamic || E2::Row == Dynamic)
     struct MatrixMult : public MatrixExpr<MatrixMult<E1, E2>> {
         using Type = typename E1::Type;
-        MatrixMult(const E1 &_x, const E2 &_y) {
-            _x.eval(x_eval);
-            _y.eval(y_eval);
+
+        // Operands whose each element is read `Reads` times. Leaf operands and
+        // their transposes are always referred, others are evaluated if costly.
+        // An evaluated operand is held in `MatrixShared`, so that copying the
+        // product (e.g., as an operand of a parent node) does not copy it.
+        template<typename E, Index Reads>
+        static constexpr bool Referred = !is_costly_v<E, Reads>;
+
+        template<typename E, Index Reads>
+        using operand_t = std::conditional_t<Referred<E, Reads>, nested_t<E>, MatrixShared<E>>;
+
+        MatrixMult(const E1 &_x, const E2 &_y) : x{operand<E2::Col>(_x)}, y{operand<E1::Row>(_y)} {
+            check_mult_size(_x, _y);
         }
 
         // Static polymorphism implementation of MatrixExpr
         INLINE auto operator()(Index r, Index c) const {
-            auto ret = x_eval(r, 0) * y_eval(0, c);
-            for (Index i = 1; i < E1::Col; i++) {
-                ret += x_eval(r, i) * y_eval(i, c);
+            auto ret = x(r, 0) * y(0, c);
+            for (Index i = 1; i < x.cols(); i++) {
+                ret += x(r, i) * y(i, c);
             }
             return ret;
         }
 
         static constexpr Index Row = E1::Row;
         static constexpr Index Col = E2::Col;
+        static constexpr bool Epilogue = true;
+        static constexpr std::size_t Cost = cost_extent_v<common_size_v<E1::Col, E2::Row>> *
+                                            (cost_v<std::remove_cvref_t<operand_t<E1, E2::Col>>> +
+                                             cost_v<std::remove_cvref_t<operand_t<E2, E1::Row>>> + 2);
+
+        // Element-wise expressions on the product are fused into `eval_row()`
+        // (See `has_epilogue`)
+        template <typename P>
+        INLINE P epilogue(Index, Index, const P &p) const {
+            return p;
+        }
+
+        INLINE const MatrixMult &product() const {
+            return *this;
+        }
+
+        /**
+         * @brief Evaluate \p r 'th row of the product into \p out .
+         * @param r Row index.
+         * @param out Array of at least `cols()` elements (reference output).
+         */
+        template <typename O>
+        INLINE void eval_row(Index r, O &out) const {
+            const Index cols = y.cols();
+            const Index inner = x.cols();
+            if constexpr (TransposedY) {
+                for (Index j=0;j<cols;j++) {
+                    out[j] = dot(r, j);
+                }
+                return;
+            }
+            for (Index j=0;j<cols;j++) {
+                out[j] = x(r, 0) * y(0, j);
+            }
+            for (Index k = 1; k < inner; k++) {
+                const auto a = x(r, k);
+                for (Index j=0;j<cols;j++) {
+                    out[j] += a * y(k, j);
+                }
+            }
+        }
+
+        INLINE Index rows() const {
+            return x.rows();
+        }
 
-        INLINE void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i, j) = x_eval(i, 0) * y_eval(0, j);
+        INLINE Index cols() const {
+            return y.cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            // Evaluated operands never overlap others
+            return x.aliases(begin, end) || y.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixMult>
+        INLINE void eval(M &_result) const {
+            const Index rows = x.rows();
+            const Index cols = y.cols();
+            const Index inner = x.cols();
+            if constexpr (!is_fixed_size_v<M>) {
+                _result.resize(rows, cols);
+            }
+            if constexpr (is_unrolled_v<Row, Col>) {
+                // Small products are evaluated element by element in unrolled code
+                evaluate(_result, *this);
+            }
+            else if constexpr (M::StorageOrder == Layout::RowMajor && TransposedX && TransposedY) {
+                // T(A) * T(B) = T(B * A), rows of B * A are scattered to columns
+                std::conditional_t<Row == Dynamic, std::vector<Type>, std::array<Type, Row>> row{};
+                if constexpr (Row == Dynamic) {
+                    row.resize(rows);
+                }
+                for (Index j=0;j<cols;j++) {
+                    for (Index i=0;i<rows;i++) {
+                        row[i] = y.x(j, 0) * x.x(0, i);
+                    }
+                    for (Index k = 1; k < inner; k++) {
+                        const auto b = y.x(j, k);
+                        for (Index i=0;i<rows;i++) {
+                            row[i] += b * x.x(k, i);
+                        }
+                    }
+                    for (Index i=0;i<rows;i++) {
+                        _result(i, j) = row[i];
+                    }
+                }
+            }
+            else if constexpr (M::StorageOrder == Layout::RowMajor && TransposedX) {
+                // T(A) * B, sum of outer products of rows of A and B
+                for (Index i=0;i<rows;i++) {
+                    const auto a = x.x(0, i);
+                    for (Index j=0;j<cols;j++) {
+                        _result(i, j) = a * y(0, j);
+                    }
+                }
+                for (Index k = 1; k < inner; k++) {
+                    for (Index i=0;i<rows;i++) {
+                        const auto a = x.x(k, i);
+                        for (Index j=0;j<cols;j++) {
+                            _result(i, j) += a * y(k, j);
+                        }
+                    }
+                }
+            }
+            else if constexpr (M::StorageOrder == Layout::RowMajor && TransposedY) {
+                // A * T(B), dot products of rows of A and B
+                for (Index i=0;i<rows;i++) {
+                    for (Index j=0;j<cols;j++) {
+                        _result(i, j) = dot(i, j);
+                    }
+                }
+            }
+            else if constexpr (M::StorageOrder == Layout::RowMajor) {
+                for (Index i=0;i<rows;i++) {
+                    for (Index j=0;j<cols;j++) {
+                        _result(i, j) = x(i, 0) * y(0, j);
+                    }
+                    for (Index k = 1; k < inner; k++) {
+                        for (Index j=0;j<cols;j++) {
+                            _result(i, j) += x(i, k) * y(k, j);
+                        }
+                    }
                 }
-                for (Index k = 1; k < E1::Col; k++) {
-                    for (int j=0;j<Col;j++) {
-                        _result(i, j) += x_eval(i, k) * y_eval(k, j);
+            }
+            else {
+                for (Index j=0;j<cols;j++) {
+                    for (Index i=0;i<rows;i++) {
+                        _result(i, j) = x(i, 0) * y(0, j);
+                    }
+                    for (Index k = 1; k < inner; k++) {
+                        for (Index i=0;i<rows;i++) {
+                            _result(i, j) += x(i, k) * y(k, j);
+                        }
                     }
                 }
             }
         }
 
-        // Specify member type as Matrix for evaluation
-        Matrix<Type, E1::Row, E1::Col> x_eval;
-        Matrix<Type, E2::Row, E2::Col> y_eval;
+        operand_t<E1, E2::Col> x;
+        operand_t<E2, E1::Row> y;
+
+    private:
+        // Transpose of a row-major leaf, whose columns are contiguous
+        template<typename E>
+        static constexpr bool row_major_transpose() {
+            if constexpr (is_transposed_leaf_v<E>) {
+                return storage_order_v<std::remove_cvref_t<decltype(std::declval<E>().x)>> == Layout::RowMajor;
+            }
+            else {
+                return false;
+            }
+        }
+
+        static constexpr bool TransposedX = row_major_transpose<E1>();
+        static constexpr bool TransposedY = row_major_transpose<E2>();
+
+        // Dot product of r'th row of x and c'th row of the leaf of y = T(B)
+        INLINE auto dot(Index r, Index c) const requires TransposedY {
+            auto ret = x(r, 0) * y.x(c, 0);
+            for (Index k = 1; k < x.cols(); k++) {
+                ret += x(r, k) * y.x(c, k);
+            }
+            return ret;
+        }
+
+        template<Index Reads, typename E>
+        static operand_t<E, Reads> operand(const E &e) {
+            if constexpr (Referred<E, Reads>) {
+                return e;
+            }
+            else {
+                return MatrixShared<E>(e);
+            }
+        }
     };
 
 }
@@ -84,14 +270,47 @@ namespace Peanut::Impl {
 namespace Peanut {
 
     /**
-     * @brief Multiplication between matrices. See `Impl::MatrixMult`.
+     * @brief Multiplication between matrices. See `Impl::MatrixMult`, and
+     *        `Impl::MatrixPackedMult` for packed operands.
      * @tparam E1 Left hand side matrix expression type.
      * @tparam E2 Right hand side matrix expression type.
      * @return Constructed `Impl::MatrixMult` instance
      */
     template<typename E1, typename E2>
-        requires(E1::Col == E2::Row)
+        requires (!is_packed_v<E1> && !is_packed_v<E2>) &&
+                 (E1::Col == E2::Row || E1::Col == Dynamic || E2::Row == Dynamic)
     Impl::MatrixMult<E1, E2> operator*(const MatrixExpr<E1> &x, const MatrixExpr<E2> &y) {
         return Impl::MatrixMult<E1, E2>(static_cast<const E1 &>(x), static_cast<const E2 &>(y));
     }
+
+    /**
+     * @brief Template specialization of `operator*()` which represents a
+     *        multiplication of negations of matrices. It is equivalent to
+     *        a multiplication of the matrices (i.e., -A * -B = A * B), so it
+     *        does not construct `MatrixNegation` instances.
+     * @tparam E1 Left hand side matrix expression type of the negation.
+     * @tparam E2 Right hand side matrix expression type of the negation.
+     * @return Product of inputs of the given parameters
+     */
+    template<typename E1, typename E2>
+        requires (E1::Col == E2::Row || E1::Col == Dynamic || E2::Row == Dynamic)
+    auto operator*(const Impl::MatrixNegation<E1> &x, const Impl::MatrixNegation<E2> &y) {
+        return static_cast<const E1 &>(x.x) * static_cast<const E2 &>(y.x);
+    }
+
+    /**
+     * @brief Template specialization of `T()` which represents a transpose
+     *        of a product of leaves or their transposes. It is rewritten as
+     *        a product of transposes (i.e., T(A * B) = T(B) * T(A)), which is
+     *        evaluated by transpose-aware kernels (See `Impl::MatrixMult`)
+     *        instead of reading the product column by column.
+     * @tparam E1 Left hand side matrix expression type of the product.
+     * @tparam E2 Right hand side matrix expression type of the product.
+     * @return Constructed `Impl::MatrixMult` instance
+     */
+    template<typename E1, typename E2>
+        requires (is_leaf_v<E1> || is_transposed_leaf_v<E1>) && (is_leaf_v<E2> || is_transposed_leaf_v<E2>)
+    auto T(const Impl::MatrixMult<E1, E2> &x) {
+        return T(static_cast<const E2 &>(x.y)) * T(static_cast<const E1 &>(x.x));
+    }
 }
@@ -27,7 +27,10 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+#include <Peanut/impl/unary_expr/shared.h>
 
 // Dependencies headers
 
@@ -53,16 +56,54 @@ namespace Peanut::Impl {
 
         static constexpr Index Row = E::Row;
         static constexpr Index Col = E::Col;
+        static constexpr bool Linear = is_linear_v<E>;
+        static constexpr Layout StorageOrder = storage_order_v<E>;
+        static constexpr bool Vectorizable = is_vectorizable_v<E> && is_packet_castable_v<typename E::Type, Type>;
+        static constexpr bool Epilogue = has_epilogue_v<E>;
+        static constexpr std::size_t Cost = cost_v<E> + 1;
 
-        INLINE void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = static_cast<Type>(x(i, j)) * static_cast<Type>(y);
-                }
-            }
+        // Flat index access, available if the expression is linearly accessible
+        INLINE Type coeff(Index i) const requires Linear {
+            return static_cast<Type>(x.coeff(i)) * static_cast<Type>(y);
         }
 
-        const E &x;
+        // SIMD packet access, available if the expression is vectorizable
+        template <bool Aligned = false>
+        INLINE Packet<Type> packet(Index i) const requires Vectorizable {
+            return packet_cast<Type>(x.template packet<Aligned>(i)) * Packet<Type>::set1(static_cast<Type>(y));
+        }
+
+        // Element given the product element at the same position, available
+        // if the expression has a product to be fused (See `has_epilogue`)
+        template <typename P>
+        INLINE Type epilogue(Index r, Index c, const P &p) const requires Epilogue {
+            return static_cast<Type>(x.epilogue(r, c, p)) * static_cast<Type>(y);
+        }
+
+        INLINE const auto &product() const requires Epilogue {
+            return x.product();
+        }
+
+        INLINE Index rows() const {
+            return x.rows();
+        }
+
+        INLINE Index cols() const {
+            return x.cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixMultScalar>
+        INLINE void eval(M &_result) const {
+            evaluate(_result, *this);
+        }
+
+        nested_t<E> x;
         T y;
     };
 }
@@ -77,8 +118,9 @@ namespace Peanut {
      */
     template<typename E, typename T>
         requires is_matrix_v<E> && std::is_arithmetic_v<T>
-    Impl::MatrixMultScalar<E, T> operator*(const MatrixExpr<E> &x, const T &y) {
-        return Impl::MatrixMultScalar<E, T>(static_cast<const E &>(x), y);
+    auto operator*(const MatrixExpr<E> &x, const T &y) {
+        decltype(auto) e = Impl::elementwise_operand(static_cast<const E &>(x));
+        return Impl::MatrixMultScalar<std::remove_cvref_t<decltype(e)>, T>(e, y);
     }
 
     /**
@@ -89,7 +131,38 @@ namespace Peanut {
      */
     template<typename E, typename T>
         requires is_matrix_v<E> && std::is_arithmetic_v<T>
-    Impl::MatrixMultScalar<E, T> operator*(const T x, const MatrixExpr<E> &y) {
-        return Impl::MatrixMultScalar<E, T>(static_cast<const E &>(y), x);
+    auto operator*(const T x, const MatrixExpr<E> &y) {
+        decltype(auto) e = Impl::elementwise_operand(static_cast<const E &>(y));
+        return Impl::MatrixMultScalar<std::remove_cvref_t<decltype(e)>, T>(e, x);
+    }
+
+    /**
+     * @brief Template specialization of `operator*()` which represents a
+     *        scalar multiplication of a scalar multiplication of a matrix.
+     *        Scalars are folded (i.e., (A * 2) * 3 = A * 6), so it does not
+     *        construct nested `MatrixMultScalar` instances.
+     * @tparam E Matrix expression type.
+     * @tparam T Scalar type of \p x .
+     * @tparam U Right hand side scalar type.
+     * @return Constructed `Impl::MatrixMultScalar` instance
+     */
+    template<typename E, typename T, typename U>
+        requires std::is_arithmetic_v<U>
+    auto operator*(const Impl::MatrixMultScalar<E, T> &x, const U &y) {
+        return static_cast<const E &>(x.x) * (x.y * y);
+    }
+
+    /**
+     * @brief Template specialization of `operator*()` which folds scalars as
+     *        `operator*(const Impl::MatrixMultScalar<E, T> &, const U &)`.
+     * @tparam U Left hand side scalar type.
+     * @tparam E Matrix expression type.
+     * @tparam T Scalar type of \p y .
+     * @return Constructed `Impl::MatrixMultScalar` instance
+     */
+    template<typename U, typename E, typename T>
+        requires std::is_arithmetic_v<U>
+    auto operator*(const U x, const Impl::MatrixMultScalar<E, T> &y) {
+        return static_cast<const E &>(y.x) * (x * y.y);
     }
 }
@@ -0,0 +1,267 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <algorithm>
+#include <type_traits>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/unary_expr/shared.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Expression class which represents `operator*()` where at least
+     *        one operand is a packed matrix (See `is_packed`).
+     * @details Packed operands are referred without unpacking, and only the
+     *          non-zero range of each row and column of a triangular operand
+     *          takes part in the product. If an operand is symmetric (See
+     *          `is_symmetric`), `eval()` walks its stored triangle once and
+     *          accumulates each element into both rows (or columns) of the
+     *          result it contributes to. Other operands are referred or
+     *          evaluated as `MatrixMult` does.
+     * @tparam E1 Left hand side matrix expression type.
+     * @tparam E2 Right hand side matrix expression type.
+     */
+    template<typename E1, typename E2>
+        requires (is_packed_v<E1> || is_packed_v<E2>) &&
+                 (E1::Col == E2::Row || E1::Col == Dynamic || E2::Row == Dynamic)
+    struct MatrixPackedMult : public MatrixExpr<MatrixPackedMult<E1, E2>> {
+        using Type = typename E1::Type;
+
+        // Leaf operands (including packed ones) are referred, others are
+        // evaluated if costly (See `MatrixMult`).
+        template<typename E, Index Reads>
+        using operand_t = std::conditional_t<!is_costly_v<E, Reads>, nested_t<E>, MatrixShared<E>>;
+
+        MatrixPackedMult(const E1 &_x, const E2 &_y) : x{operand<E2::Col>(_x)}, y{operand<E1::Row>(_y)} {
+            check_mult_size(_x, _y);
+        }
+
+        // Static polymorphism implementation of MatrixExpr
+        INLINE auto operator()(Index r, Index c) const {
+            const Index begin = std::max(row_begin<E1>(r), col_begin<E2>(c));
+            const Index end = std::min(row_end<E1>(x, r), col_end<E2>(y, c));
+            Type ret = static_cast<Type>(0);
+            for (Index k = begin; k < end; k++) {
+                ret += x(r, k) * y(k, c);
+            }
+            return ret;
+        }
+
+        static constexpr Index Row = E1::Row;
+        static constexpr Index Col = E2::Col;
+        static constexpr std::size_t Cost = cost_extent_v<common_size_v<E1::Col, E2::Row>> *
+                                            (cost_v<std::remove_cvref_t<operand_t<E1, E2::Col>>> +
+                                             cost_v<std::remove_cvref_t<operand_t<E2, E1::Row>>> + 2);
+
+        INLINE Index rows() const {
+            return x.rows();
+        }
+
+        INLINE Index cols() const {
+            return y.cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end) || y.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixPackedMult>
+        INLINE void eval(M &_result) const {
+            const Index rows = x.rows();
+            const Index cols = y.cols();
+            if constexpr (!is_fixed_size_v<M>) {
+                _result.resize(rows, cols);
+            }
+            if constexpr (is_unrolled_v<Row, Col>) {
+                // Small products are evaluated element by element in unrolled code
+                evaluate(_result, *this);
+            }
+            else if constexpr (is_symmetric_v<E1> || is_symmetric_v<E2>) {
+                eval_symmetric(_result);
+            }
+            else if constexpr (M::StorageOrder == Layout::RowMajor) {
+                for (Index i=0;i<rows;i++) {
+                    for (Index j=0;j<cols;j++) {
+                        _result(i, j) = static_cast<Type>(0);
+                    }
+                    for (Index k = row_begin<E1>(i); k < row_end<E1>(x, i); k++) {
+                        const Type a = x(i, k);
+                        for (Index j = row_begin<E2>(k); j < row_end<E2>(y, k); j++) {
+                            _result(i, j) += a * y(k, j);
+                        }
+                    }
+                }
+            }
+            else {
+                for (Index j=0;j<cols;j++) {
+                    for (Index i=0;i<rows;i++) {
+                        _result(i, j) = static_cast<Type>(0);
+                    }
+                    for (Index k = col_begin<E2>(j); k < col_end<E2>(y, j); k++) {
+                        const Type b = y(k, j);
+                        for (Index i = col_begin<E1>(k); i < col_end<E1>(x, k); i++) {
+                            _result(i, j) += x(i, k) * b;
+                        }
+                    }
+                }
+            }
+        }
+
+        operand_t<E1, E2::Col> x;
+        operand_t<E2, E1::Row> y;
+
+    private:
+        // Product with a symmetric operand. Stored element `a` at (i, k),
+        // k <= i, is read once and used as both (i, k) and (k, i).
+        template <typename M>
+        INLINE void eval_symmetric(M &_result) const {
+            const Index rows = x.rows();
+            const Index cols = y.cols();
+            for_each_index_sized<M::StorageOrder, Row, Col>(rows, cols, [&](Index r, Index c) {
+                _result(r, c) = static_cast<Type>(0);
+            });
+            if constexpr (is_symmetric_v<E1>) {
+                // Row i and k of the result take row k and i of y
+                auto accumulate = [&](Index j_begin, Index j_end) {
+                    Index idx = 0;
+                    for (Index i = 0; i < rows; i++) {
+                        for (Index k = 0; k <= i; k++) {
+                            const Type a = x.m_data[idx++];
+                            for (Index j = j_begin; j < j_end; j++) {
+                                _result(i, j) += a * y(k, j);
+                            }
+                            if (k != i) {
+                                for (Index j = j_begin; j < j_end; j++) {
+                                    _result(k, j) += a * y(i, j);
+                                }
+                            }
+                        }
+                    }
+                };
+                if constexpr (M::StorageOrder == Layout::RowMajor) {
+                    accumulate(0, cols);
+                }
+                else {
+                    // Keep the column of the result in cache
+                    for (Index j = 0; j < cols; j++) {
+                        accumulate(j, j + 1);
+                    }
+                }
+            }
+            else {
+                // Column k and i of the result take column i and k of x
+                auto accumulate = [&](Index r_begin, Index r_end) {
+                    Index idx = 0;
+                    for (Index i = 0; i < cols; i++) {
+                        for (Index k = 0; k <= i; k++) {
+                            const Type a = y.m_data[idx++];
+                            for (Index r = r_begin; r < r_end; r++) {
+                                _result(r, k) += x(r, i) * a;
+                            }
+                            if (k != i) {
+                                for (Index r = r_begin; r < r_end; r++) {
+                                    _result(r, i) += x(r, k) * a;
+                                }
+                            }
+                        }
+                    }
+                };
+                if constexpr (M::StorageOrder == Layout::ColMajor) {
+                    accumulate(0, rows);
+                }
+                else {
+                    // Keep the row of the result in cache
+                    for (Index r = 0; r < rows; r++) {
+                        accumulate(r, r + 1);
+                    }
+                }
+            }
+        }
+
+        template<Index Reads, typename E>
+        static operand_t<E, Reads> operand(const E &e) {
+            if constexpr (!is_costly_v<E, Reads>) {
+                return e;
+            }
+            else {
+                return MatrixShared<E>(e);
+            }
+        }
+
+        // Non-zero range of the row/column of an operand. Dense operands
+        // span all of it.
+        template<typename E>
+        INLINE static Index row_begin(Index r) {
+            if constexpr (is_packed_v<E>) { return E::row_begin(r); }
+            else { return 0; }
+        }
+
+        template<typename E, typename O>
+        INLINE static Index row_end(const O &o, Index r) {
+            if constexpr (is_packed_v<E>) { return E::row_end(r); }
+            else { return o.cols(); }
+        }
+
+        template<typename E>
+        INLINE static Index col_begin(Index c) {
+            if constexpr (is_packed_v<E>) { return E::col_begin(c); }
+            else { return 0; }
+        }
+
+        template<typename E, typename O>
+        INLINE static Index col_end(const O &o, Index c) {
+            if constexpr (is_packed_v<E>) { return E::col_end(c); }
+            else { return o.rows(); }
+        }
+    };
+
+}
+
+namespace Peanut {
+
+    /**
+     * @brief Multiplication with packed matrices. See `Impl::MatrixPackedMult`.
+     * @tparam E1 Left hand side matrix expression type.
+     * @tparam E2 Right hand side matrix expression type.
+     * @return Constructed `Impl::MatrixPackedMult` instance
+     */
+    template<typename E1, typename E2>
+        requires (is_packed_v<E1> || is_packed_v<E2>) &&
+                 (E1::Col == E2::Row || E1::Col == Dynamic || E2::Row == Dynamic)
+    Impl::MatrixPackedMult<E1, E2> operator*(const MatrixExpr<E1> &x, const MatrixExpr<E2> &y) {
+        return Impl::MatrixPackedMult<E1, E2>(static_cast<const E1 &>(x), static_cast<const E2 &>(y));
+    }
+}
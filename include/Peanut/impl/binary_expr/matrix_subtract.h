@@ -27,7 +27,11 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+#include <Peanut/impl/unary_expr/shared.h>
+#include <Peanut/impl/unary_expr/transpose.h>
 
 // Dependencies headers
 
@@ -42,26 +46,77 @@ namespace Peanut::Impl {
         requires is_equal_size_mat_v<E1, E2>
     struct MatrixSubtract : public MatrixExpr<MatrixSubtract<E1, E2>> {
         using Type = typename E1::Type;
-        MatrixSubtract(const E1 &x, const E2 &y) : x{x}, y{y} {}
+        MatrixSubtract(const E1 &x, const E2 &y) : x{x}, y{y} {
+            check_equal_size(x, y);
+        }
 
         // Static polymorphism implementation of MatrixExpr
         INLINE auto operator()(Index r, Index c) const {
             return x(r, c) - y(r, c);
         }
 
-        static constexpr Index Row = E1::Row;
-        static constexpr Index Col = E1::Col;
+        static constexpr Index Row = common_size_v<E1::Row, E2::Row>;
+        static constexpr Index Col = common_size_v<E1::Col, E2::Col>;
+        static constexpr bool Linear = is_linear_pair_v<E1, E2>;
+        static constexpr Layout StorageOrder = storage_order_v<E1>;
+        static constexpr bool Vectorizable = Linear && is_vectorizable_v<E1> && is_vectorizable_v<E2> &&
+                                             std::is_same_v<typename E1::Type, typename E2::Type>;
+        static constexpr bool Epilogue = has_epilogue_v<E1> != has_epilogue_v<E2>;
+        static constexpr std::size_t Cost = cost_v<E1> + cost_v<E2> + 1;
+
+        // Flat index access, available if the expression is linearly accessible
+        INLINE auto coeff(Index i) const requires Linear {
+            return x.coeff(i) - y.coeff(i);
+        }
+
+        // SIMD packet access, available if the expression is vectorizable
+        template <bool Aligned = false>
+        INLINE Packet<Type> packet(Index i) const requires Vectorizable {
+            return x.template packet<Aligned>(i) - y.template packet<Aligned>(i);
+        }
+
+        // Element given the product element at the same position, available
+        // if the expression has a product to be fused (See `has_epilogue`)
+        template <typename P>
+        INLINE auto epilogue(Index r, Index c, const P &p) const requires Epilogue {
+            if constexpr (has_epilogue_v<E1>) {
+                return x.epilogue(r, c, p) - y(r, c);
+            }
+            else {
+                return x(r, c) - y.epilogue(r, c, p);
+            }
+        }
 
-        INLINE void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = x(i, j) - y(i, j);
-                }
+        INLINE const auto &product() const requires Epilogue {
+            if constexpr (has_epilogue_v<E1>) {
+                return x.product();
             }
+            else {
+                return y.product();
+            }
+        }
+
+        INLINE Index rows() const {
+            return x.rows();
         }
 
-        const E1 &x;
-        const E2 &y;
+        INLINE Index cols() const {
+            return x.cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end) || y.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixSubtract>
+        INLINE void eval(M &_result) const {
+            evaluate(_result, *this);
+        }
+
+        nested_t<E1> x;
+        nested_t<E2> y;
     };
 }
 
@@ -75,7 +130,22 @@ namespace Peanut {
      */
     template<typename E1, typename E2>
         requires is_equal_size_mat_v<E1, E2>
-    Impl::MatrixSubtract<E1, E2> operator-(const MatrixExpr<E1> &x, const MatrixExpr<E2> &y) {
-        return Impl::MatrixSubtract<E1, E2>(static_cast<const E1 &>(x), static_cast<const E2 &>(y));
+    auto operator-(const MatrixExpr<E1> &x, const MatrixExpr<E2> &y) {
+        return Impl::make_elementwise<Impl::MatrixSubtract>(static_cast<const E1 &>(x), static_cast<const E2 &>(y));
+    }
+
+    /**
+     * @brief Template specialization of `T()` which represents a transpose
+     *        of a difference including a transpose. It is distributed over the
+     *        operands (i.e., T(T(A) - B) = A - T(B)) so that the transposes
+     *        cancel out.
+     * @tparam E1 Left hand side matrix expression type of the difference.
+     * @tparam E2 Right hand side matrix expression type of the difference.
+     * @return Difference of transposes of the operands
+     */
+    template<typename E1, typename E2>
+        requires is_transpose_v<E1> || is_transpose_v<E2>
+    auto T(const Impl::MatrixSubtract<E1, E2> &x) {
+        return T(static_cast<const E1 &>(x.x)) - T(static_cast<const E2 &>(x.y));
     }
 }
@@ -25,8 +25,11 @@
 #pragma once
 
 // Standard headers
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <stdexcept>
 #include <utility>
 #include <iostream>
 
@@ -40,10 +43,43 @@
 #define INLINE __attribute__((always_inline)) inline
 #endif
 
+/**
+ * @brief Maximum number of elements of a fixed-size matrix which is
+ *        evaluated by fully unrolled code. Larger matrices are evaluated by
+ *        runtime loops. See `for_each_index_sized()`.
+ *        It can be overridden by defining it before including Peanut.
+ */
+#ifndef PEANUT_UNROLL_LIMIT
+#define PEANUT_UNROLL_LIMIT 16
+#endif
+
+/**
+ * @brief Edge size of square blocks which runtime loops visit matrix
+ *        elements by. See `for_each_index_sized()`.
+ *        It can be overridden by defining it before including Peanut.
+ */
+#ifndef PEANUT_BLOCK_SIZE
+#define PEANUT_BLOCK_SIZE 32
+#endif
+
 namespace Peanut {
     using Index = unsigned int;
     using Float = float;
 
+    /**
+     * @brief Row or column size of a matrix expression whose size is
+     *        determined in runtime (e.g., `DynMatrix`).
+     */
+    constexpr Index Dynamic = 0;
+
+    /**
+     * @brief Storage order of matrix elements.
+     */
+    enum class Layout {
+        RowMajor,
+        ColMajor
+    };
+
     /**
      * @brief Check if given \p val is zero or not.
      * @param[in] val Arithmetic type value which will be checked.
@@ -103,4 +139,151 @@ namespace Peanut {
         for_(func, std::make_index_sequence<N>());
     }
 
+    /**
+     * @brief Function which visits every (row, column) index pair in the
+     *        given storage order, so that a matrix stored in \p L layout is
+     *        accessed contiguously.
+     * @param rows Row size.
+     * @param cols Column size.
+     * @param func Callable object which will be called with row and column index.
+     * @tparam L Storage order of traversal.
+     * @tparam F Arbitrary type, intended to be callable types (std::function, lambda, etc)
+     */
+    template <Layout L, typename F>
+    INLINE void for_each_index(Index rows, Index cols, F func)
+    {
+        if constexpr (L == Layout::RowMajor) {
+            for (Index r = 0; r < rows; r++) {
+                for (Index c = 0; c < cols; c++) {
+                    func(r, c);
+                }
+            }
+        }
+        else {
+            for (Index c = 0; c < cols; c++) {
+                for (Index r = 0; r < rows; r++) {
+                    func(r, c);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Compile-time checking structure if a matrix of \p R x \p C
+     *        elements is small enough to be evaluated by fully unrolled code,
+     *        i.e., its size is fixed and it has at most `PEANUT_UNROLL_LIMIT`
+     *        elements.
+     */
+    template <Index R, Index C>
+    struct is_unrolled{
+        static constexpr bool value = R != Dynamic && C != Dynamic && R * C <= PEANUT_UNROLL_LIMIT;
+    };
+
+    /**
+     * @brief Helper variable template for `is_unrolled<R, C>`.
+     */
+    template <Index R, Index C>
+    constexpr bool is_unrolled_v = is_unrolled<R, C>::value;
+
+    /**
+     * @brief Function which visits every (row, column) index pair as
+     *        `for_each_index()` does, by code chosen by the compile-time size
+     *        \p R x \p C of the matrix. Small matrices (See `is_unrolled`)
+     *        are visited by a fully unrolled sequence of calls without loop
+     *        overhead. Others are visited by runtime loops over square blocks
+     *        of `PEANUT_BLOCK_SIZE` in the storage order, so that operands
+     *        read in the other order (e.g., transposes) stay in cache.
+     * @param rows Row size.
+     * @param cols Column size.
+     * @param func Callable object which will be called with row and column index.
+     * @tparam L Storage order of traversal.
+     * @tparam R Compile-time row size, which may be `Dynamic`.
+     * @tparam C Compile-time column size, which may be `Dynamic`.
+     * @tparam F Arbitrary type, intended to be callable types (std::function, lambda, etc)
+     */
+    template <Layout L, Index R, Index C, typename F>
+    INLINE void for_each_index_sized(Index rows, Index cols, F func)
+    {
+        constexpr bool RowMajor = (L == Layout::RowMajor);
+        if constexpr (is_unrolled_v<R, C>) {
+            for_<R * C>([&](auto i) {
+                constexpr Index o = i.value / (RowMajor ? C : R);
+                constexpr Index n = i.value % (RowMajor ? C : R);
+                if constexpr (RowMajor) {
+                    func(o, n);
+                }
+                else {
+                    func(n, o);
+                }
+            });
+        }
+        else {
+            constexpr Index B = PEANUT_BLOCK_SIZE;
+            const Index outer = RowMajor ? rows : cols;
+            const Index inner = RowMajor ? cols : rows;
+            if (inner <= B) {
+                for_each_index<L>(rows, cols, func);
+                return;
+            }
+            for (Index o0 = 0; o0 < outer; o0 += B) {
+                const Index o1 = std::min(o0 + B, outer);
+                for (Index n0 = 0; n0 < inner; n0 += B) {
+                    const Index n1 = std::min(n0 + B, inner);
+                    for (Index o = o0; o < o1; o++) {
+                        for (Index n = n0; n < n1; n++) {
+                            if constexpr (RowMajor) {
+                                func(o, n);
+                            }
+                            else {
+                                func(n, o);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+}
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Check if given matrix expressions have same size in runtime.
+     *        It is a no-op if both sizes are known at compile-time.
+     * @param x Arbitrary Peanut matrix expression.
+     * @param y Arbitrary Peanut matrix expression.
+     */
+    template <typename E1, typename E2>
+    INLINE void check_equal_size(const E1 &x, const E2 &y) {
+        if constexpr (E1::Row == Dynamic || E1::Col == Dynamic || E2::Row == Dynamic || E2::Col == Dynamic) {
+            if (x.rows() != y.rows() || x.cols() != y.cols()) {
+                throw std::invalid_argument("Matrix size mismatch");
+            }
+        }
+    }
+
+    /**
+     * @brief Check if given matrix expressions can be multiplied in runtime.
+     *        It is a no-op if both sizes are known at compile-time.
+     * @param x Left hand side Peanut matrix expression.
+     * @param y Right hand side Peanut matrix expression.
+     */
+    template <typename E1, typename E2>
+    INLINE void check_mult_size(const E1 &x, const E2 &y) {
+        if constexpr (E1::Col == Dynamic || E2::Row == Dynamic) {
+            if (x.cols() != y.rows()) {
+                throw std::invalid_argument("Matrix size mismatch");
+            }
+        }
+    }
+
+    /**
+     * @brief Check if memory ranges [\p begin1, \p end1) and [\p begin2, \p end2) overlap.
+     * @return True if they overlap.
+     */
+    template <typename T>
+    INLINE bool overlaps(const T *begin1, const T *end1, const T *begin2, const T *end2) {
+        return std::less<const T *>{}(begin1, end2) && std::less<const T *>{}(begin2, end1);
+    }
 }
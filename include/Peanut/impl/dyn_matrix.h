@@ -0,0 +1,408 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix.h>
+#include <Peanut/impl/matrix_eval.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+
+// Dependencies headers
+
+namespace Peanut {
+
+    /**
+     * @brief Matrix class whose size is determined in runtime.
+     * @details Elements are stored in a heap buffer. Its `Row` and `Col` are
+     *          `Dynamic`, and the actual size is given by `rows()` and `cols()`.
+     *          It can be mixed with fixed-size matrix expressions, in which case
+     *          sizes are checked in runtime and `std::invalid_argument` is
+     *          thrown if they do not match.
+     *
+     *     Peanut::DynMatrix<float> dyn(2, 3);
+     *     Peanut::Matrix<float, 2, 3> mat = dyn + dyn;
+     *     Peanut::DynMatrix<float> back = T(mat) * dyn;
+     *
+     * @tparam T Data type.
+     * @tparam L Storage order of elements. See `Layout`.
+     */
+    template<typename T, Layout L = Layout::RowMajor> requires std::is_arithmetic_v<T>
+    struct DynMatrix : public MatrixExpr<DynMatrix<T, L>>{
+
+        /**
+         * @brief Data type. See the detailed description of \p MatrixExpr.
+         */
+        using Type = T;
+
+        /**
+         * @brief Row size of the matrix, which is `Dynamic`.
+         */
+        static constexpr Index Row = Dynamic;
+
+        /**
+         * @brief Column size of the matrix, which is `Dynamic`.
+         */
+        static constexpr Index Col = Dynamic;
+
+        /**
+         * @brief Storage order of elements in `m_data`.
+         */
+        static constexpr Layout StorageOrder = L;
+
+        /**
+         * @brief Elements are referred directly. See `is_leaf`.
+         */
+        static constexpr bool Leaf = true;
+
+        /**
+         * @brief Elements are always stored without padding. See `is_linear`.
+         */
+        static constexpr bool Linear = true;
+
+        /**
+         * @brief True if elements can be loaded as SIMD packets. See `is_vectorizable`.
+         */
+        static constexpr bool Vectorizable = Impl::has_packet_v<T>;
+
+        /**
+         * @brief Constructor of an empty (0x0) matrix.
+         */
+        DynMatrix() : m_rows{0}, m_cols{0} {}
+
+        /**
+         * @brief Constructor without any initialization of elements.
+         * @param rows Row size.
+         * @param cols Column size.
+         */
+        DynMatrix(Index rows, Index cols) : m_rows{rows}, m_cols{cols}, m_data(rows * cols) {}
+
+        /**
+         * @brief Constructor with std::vector.
+         * @param rows Row size.
+         * @param cols Column size.
+         * @param data std::vector having `T` type and \p rows * \p cols size,
+         *             in the storage order of the matrix.
+         */
+        DynMatrix(Index rows, Index cols, const std::vector<T> &data) : m_rows{rows}, m_cols{cols}, m_data(data) {
+            if (data.size() != rows * cols) {
+                throw std::invalid_argument("Matrix size mismatch");
+            }
+        }
+
+        /**
+         * @brief Constructor from arbitrary Peanut matrix expression, including
+         *        fixed-size `Matrix`. The size is taken from the expression.
+         * @param expr Arbitrary Peanut matrix expression.
+         */
+        template<typename E>
+        DynMatrix(const MatrixExpr<E> &expr) requires is_equal_type_v<E, DynMatrix>
+            : m_rows{expr.rows()}, m_cols{expr.cols()}, m_data(m_rows * m_cols) {
+            static_cast<const E&>(expr).eval(*this);
+        }
+
+        /**
+         * @brief Evaluate arbitrary Peanut matrix expression into the matrix.
+         *        The matrix is resized to the size of \p expr.
+         * @details If \p expr reads elements of this matrix (See `aliases()`),
+         *          it is evaluated into a temporary matrix first. It is skipped
+         *          at compile-time if \p expr is element-wise and linearly
+         *          accessible (See `is_linear`), since every element is read
+         *          before it is written. Use `noalias()` to skip it explicitly.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        DynMatrix &operator=(const MatrixExpr<E> &expr) requires is_equal_type_v<E, DynMatrix>{
+            const E &e = static_cast<const E&>(expr);
+            if constexpr (!is_linear_pair_v<DynMatrix, E>){
+                const T *p = std::as_const(m_data).data();
+                if(e.aliases(p, p + m_data.size())){
+                    *this = DynMatrix(e);
+                    return *this;
+                }
+            }
+            e.eval(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Get a proxy of the matrix whose assignment does not check
+         *        aliasing.
+         *
+         *     mat.noalias() = a * b + c;
+         *
+         * @return `Impl::NoAlias` instance referring this matrix.
+         */
+        INLINE Impl::NoAlias<DynMatrix> noalias(){
+            return {*this};
+        }
+
+        /**
+         * @brief Add arbitrary Peanut matrix expression to the matrix in place.
+         *        See `Matrix::operator+=()`.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        DynMatrix &operator+=(const MatrixExpr<E> &expr) requires is_equal_type_v<E, DynMatrix>{
+            const T *p = std::as_const(m_data).data();
+            Impl::compound_assign(*this, static_cast<const E&>(expr), p, p + m_data.size(),
+                                  [](const auto &x, const auto &y){ return x + y; });
+            return *this;
+        }
+
+        /**
+         * @brief Subtract arbitrary Peanut matrix expression from the matrix
+         *        in place. See `Matrix::operator-=()`.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        DynMatrix &operator-=(const MatrixExpr<E> &expr) requires is_equal_type_v<E, DynMatrix>{
+            const T *p = std::as_const(m_data).data();
+            Impl::compound_assign(*this, static_cast<const E&>(expr), p, p + m_data.size(),
+                                  [](const auto &x, const auto &y){ return x - y; });
+            return *this;
+        }
+
+        /**
+         * @brief Multiply the matrix by square Peanut matrix expression in
+         *        place. See `Matrix::operator*=()`.
+         * @param expr Square Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        DynMatrix &operator*=(const MatrixExpr<E> &expr) requires is_equal_type_v<E, DynMatrix> && is_square_v<E>{
+            const T *p = std::as_const(m_data).data();
+            Impl::multiply_assign(*this, static_cast<const E&>(expr), p, p + m_data.size());
+            return *this;
+        }
+
+        /**
+         * @brief Multiply the matrix by scalar in place. See `Matrix::operator*=()`.
+         * @param scalar Scalar value.
+         * @return Reference of this instance.
+         */
+        DynMatrix &operator*=(T scalar) requires (!std::is_floating_point_v<T> || std::is_same_v<T, Float>){
+            (std::as_const(*this) * scalar).eval(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Divide the matrix by scalar in place. See `Matrix::operator/=()`.
+         * @param scalar Scalar value.
+         * @return Reference of this instance.
+         */
+        DynMatrix &operator/=(T scalar) requires std::is_same_v<T, Float>{
+            (std::as_const(*this) / scalar).eval(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Factory function for zero matrix
+         * @param rows Row size.
+         * @param cols Column size.
+         * @return Zero matrix with given size.
+         */
+        static DynMatrix zeros(Index rows, Index cols) {
+            DynMatrix m(rows, cols);
+            std::fill(m.m_data.begin(), m.m_data.end(), static_cast<T>(0));
+            return m;
+        }
+
+        /**
+         * @brief Construct identity matrix.
+         * @param n Row and column size.
+         * @return Identity matrix with given size.
+         */
+        static DynMatrix identity(Index n) {
+            DynMatrix m = zeros(n, n);
+            for (Index i = 0; i < n; i++) {
+                m(i, i) = static_cast<T>(1);
+            }
+            return m;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::rows()`.
+         * @return Row size.
+         */
+        INLINE Index rows() const{
+            return m_rows;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::cols()`.
+         * @return Column size.
+         */
+        INLINE Index cols() const{
+            return m_cols;
+        }
+
+        /**
+         * @brief Change the size of the matrix. Elements are not preserved
+         *        unless the number of elements is unchanged.
+         * @param rows Row size.
+         * @param cols Column size.
+         */
+        void resize(Index rows, Index cols){
+            m_rows = rows;
+            m_cols = cols;
+            m_data.resize(rows * cols);
+        }
+
+        /**
+         * @brief Position of the element in \p r 'th row and \p c 'th column in `m_data`.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Index of `m_data`.
+         */
+        INLINE Index index(Index r, Index c) const{
+            if constexpr (L == Layout::RowMajor){
+                return r*m_cols+c;
+            }
+            else{
+                return c*m_rows+r;
+            }
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::operator()` which returns rvalue.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Rvalue of an element in \p r 'th Row and \p c 'th column.
+         */
+        INLINE T operator()(Index r, Index c) const{
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Get an element by a flat index in the storage order.
+         * @param i Flat index.
+         * @return Rvalue of `m_data[i]`.
+         */
+        INLINE T coeff(Index i) const{
+            return m_data[i];
+        }
+
+        /**
+         * @brief Load SIMD packet of elements from a flat index in the
+         *        storage order. See `coeff()`.
+         * @param i Flat index of the first element.
+         * @tparam Aligned Ignored, as elements are not over-aligned.
+         * @return `Impl::Packet<T>` instance.
+         */
+        template <bool Aligned = false>
+        INLINE Impl::Packet<T> packet(Index i) const requires Vectorizable{
+            return Impl::Packet<T>::load(&(m_data[i]));
+        }
+
+        /**
+         * @brief Get a reference of element in \p r 'th row and \p c 'th column.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Reference of an element in \p r 'th Row and \p c 'th column.
+         */
+        INLINE T& operator()(Index r, Index c) {
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Check if elements of the matrix overlap the memory [\p begin, \p end).
+         *        It is used to detect aliasing in assignment, and is false for
+         *        different element types at compile-time.
+         * @param begin Pointer to the first element of the memory.
+         * @param end Pointer past the last element of the memory.
+         * @return True if they overlap.
+         */
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const{
+            if constexpr (std::is_same_v<V, T>){
+                const T *p = m_data.data();
+                return Impl::overlaps(p, p + m_data.size(), begin, end);
+            }
+            else{
+                return false;
+            }
+        }
+
+        /**
+         * @brief Evaluation expressions and return as a matrix instance.
+         *        See `Matrix::eval()`.
+         * @param Evaluated matrix (reference output)
+         * @tparam M Type of the evaluated matrix. If it is a fixed-size
+         *           `Matrix`, the size is checked in runtime.
+         */
+        template <typename M> requires is_equal_type_size_v<M, DynMatrix>
+        void eval(M &_result) const{
+            if constexpr (std::is_same_v<M, DynMatrix>){
+                _result = *this;
+            }
+            else{
+                Impl::check_equal_size(_result, *this);
+                Impl::evaluate(_result, *this);
+            }
+        }
+
+        /**
+         * @brief An implementation of `operator<<`
+         * @return Given std::ostream
+         */
+        friend std::ostream &operator<<(std::ostream &os, const DynMatrix &matrix) {
+            for(Index r=0;r< matrix.rows();r++){
+                for(Index c=0;c< matrix.cols();c++){
+                    os << matrix(r, c)<<" ";
+                }
+            }
+            return os;
+        }
+
+        // Matrix data. Element (r, c) is located at `m_data[index(r, c)]`.
+        Index m_rows;
+        Index m_cols;
+        std::vector<T> m_data;
+    };
+
+    // Temporaries are unpadded, so that they stay linearly accessible
+    // (See `is_linear`). Use `PaddedMatrix` to avoid cache-set aliasing.
+    template <typename E>
+    struct eval_type<E, true>{
+        using type = Matrix<typename E::Type, E::Row, E::Col>;
+    };
+
+    template <typename E>
+    struct eval_type<E, false>{
+        using type = DynMatrix<typename E::Type>;
+    };
+}
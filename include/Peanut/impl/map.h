@@ -0,0 +1,306 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <type_traits>
+#include <utility>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
+#include <Peanut/impl/matrix_type_traits.h>
+
+// Dependencies headers
+
+namespace Peanut {
+
+    /**
+     * @brief Non-owning matrix which maps an external memory.
+     * @details Element (r, c) is located at `data[r*outer_stride + c*inner_stride]`
+     *          for `Layout::RowMajor`, and `data[c*outer_stride + r*inner_stride]`
+     *          for `Layout::ColMajor`. Assigning a matrix expression writes
+     *          through to the mapped memory, unless \p T is const-qualified.
+     *          The mapped memory must outlive the `Map` instance.
+     *
+     *     float buffer[6] = {1,2,3,4,5,6};
+     *     Peanut::Map<float, 2, 3> map(buffer);
+     *     Peanut::Matrix<float, 3, 3> ev = T(map) * map;
+     *     map = map * 2.0f;  // buffer is {2,4,6,8,10,12}
+     *
+     * @tparam T Data type, which may be const-qualified for read-only mapping.
+     * @tparam R Row size.
+     * @tparam C Column size.
+     * @tparam L Storage order of the mapped memory. See `Layout`.
+     */
+    template<typename T, Index R, Index C, Layout L = Layout::RowMajor>
+        requires std::is_arithmetic_v<T> && (R > 0) && (C > 0)
+    struct Map : public MatrixExpr<Map<T, R, C, L>>{
+
+        /**
+         * @brief Data type. See the detailed description of \p MatrixExpr.
+         */
+        using Type = std::remove_const_t<T>;
+
+        /**
+         * @brief Row size of the matrix.
+         */
+        static constexpr Index Row = R;
+
+        /**
+         * @brief Column size of the matrix.
+         */
+        static constexpr Index Col = C;
+
+        /**
+         * @brief Storage order of the mapped memory.
+         */
+        static constexpr Layout StorageOrder = L;
+
+        /**
+         * @brief Elements are referred directly. See `is_leaf`.
+         */
+        static constexpr bool Leaf = true;
+
+        /**
+         * @brief Constructor with a pointer to the external memory.
+         * @param data Pointer to the element (0, 0).
+         * @param outer_stride Distance between the first elements of adjacent
+         *                     rows (columns for `Layout::ColMajor`).
+         * @param inner_stride Distance between adjacent elements in a row
+         *                     (column for `Layout::ColMajor`).
+         */
+        explicit Map(T *data, Index outer_stride = (L == Layout::RowMajor ? C : R), Index inner_stride = 1)
+            : m_data{data}, m_outer_stride{outer_stride}, m_inner_stride{inner_stride} {}
+
+        Map(const Map &) = default;
+
+        /**
+         * @brief Copy elements of \p other to the mapped memory.
+         * @param other `Map` instance.
+         * @return Reference of this instance.
+         */
+        Map &operator=(const Map &other) requires (!std::is_const_v<T>){
+            return *this = static_cast<const MatrixExpr<Map>&>(other);
+        }
+
+        /**
+         * @brief Evaluate an arbitrary Peanut matrix expression into the
+         *        mapped memory.
+         * @details If \p expr reads the mapped memory (See `aliases()`), it
+         *          is evaluated into a temporary matrix first. Use `noalias()`
+         *          to skip it.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+            requires is_equal_type_size_v<E, Map> && (!std::is_const_v<T>)
+        Map &operator=(const MatrixExpr<E> &expr){
+            const E &e = static_cast<const E&>(expr);
+            Impl::check_equal_size(*this, e);
+            if(e.aliases(static_cast<const Type *>(m_data), m_data + index(R - 1, C - 1) + 1)){
+                eval_t<E> tmp;
+                e.eval(tmp);
+                tmp.eval(*this);
+            }
+            else{
+                e.eval(*this);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Get a proxy of the map whose assignment does not check
+         *        aliasing. See `Matrix::noalias()`.
+         * @return `Impl::NoAlias` instance referring this map.
+         */
+        INLINE Impl::NoAlias<Map> noalias() requires (!std::is_const_v<T>){
+            return {*this};
+        }
+
+        /**
+         * @brief Add arbitrary Peanut matrix expression to the mapped memory
+         *        in place. See `Matrix::operator+=()`.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+            requires is_equal_type_size_v<E, Map> && (!std::is_const_v<T>)
+        Map &operator+=(const MatrixExpr<E> &expr){
+            Impl::compound_assign(*this, static_cast<const E&>(expr), m_data, m_data + index(R - 1, C - 1) + 1,
+                                  [](const auto &x, const auto &y){ return x + y; });
+            return *this;
+        }
+
+        /**
+         * @brief Subtract arbitrary Peanut matrix expression from the mapped
+         *        memory in place. See `Matrix::operator-=()`.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+            requires is_equal_type_size_v<E, Map> && (!std::is_const_v<T>)
+        Map &operator-=(const MatrixExpr<E> &expr){
+            Impl::compound_assign(*this, static_cast<const E&>(expr), m_data, m_data + index(R - 1, C - 1) + 1,
+                                  [](const auto &x, const auto &y){ return x - y; });
+            return *this;
+        }
+
+        /**
+         * @brief Multiply the mapped memory by scalar in place.
+         *        See `Matrix::operator*=()`.
+         * @param scalar Scalar value.
+         * @return Reference of this instance.
+         */
+        Map &operator*=(Type scalar)
+            requires (!std::is_const_v<T>) && (!std::is_floating_point_v<Type> || std::is_same_v<Type, Float>){
+            (std::as_const(*this) * scalar).eval(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::rows()`.
+         * @return \p R
+         */
+        INLINE static constexpr Index rows(){
+            return R;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::cols()`.
+         * @return \p C
+         */
+        INLINE static constexpr Index cols(){
+            return C;
+        }
+
+        /**
+         * @brief Position of the element in \p r 'th row and \p c 'th column
+         *        from the mapped pointer.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Offset from `data()`.
+         */
+        INLINE Index index(Index r, Index c) const{
+            if constexpr (L == Layout::RowMajor){
+                return r*m_outer_stride + c*m_inner_stride;
+            }
+            else{
+                return c*m_outer_stride + r*m_inner_stride;
+            }
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::operator()` which returns rvalue.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Rvalue of an element in \p r 'th Row and \p c 'th column.
+         */
+        INLINE Type operator()(Index r, Index c) const{
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Get a reference of element in \p r 'th row and \p c 'th column.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Reference of an element in \p r 'th Row and \p c 'th column.
+         */
+        INLINE T& operator()(Index r, Index c){
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Get the mapped pointer.
+         * @return Pointer to the element (0, 0).
+         */
+        INLINE T *data() const{
+            return m_data;
+        }
+
+        /**
+         * @brief Get the outer stride.
+         * @return Distance between the first elements of adjacent rows
+         *         (columns for `Layout::ColMajor`).
+         */
+        INLINE Index outer_stride() const{
+            return m_outer_stride;
+        }
+
+        /**
+         * @brief Get the inner stride.
+         * @return Distance between adjacent elements in a row (column for
+         *         `Layout::ColMajor`).
+         */
+        INLINE Index inner_stride() const{
+            return m_inner_stride;
+        }
+
+        /**
+         * @brief Check if elements of the matrix overlap the memory [\p begin, \p end).
+         *        It is used to detect aliasing in assignment, and is false for
+         *        different element types at compile-time.
+         * @param begin Pointer to the first element of the memory.
+         * @param end Pointer past the last element of the memory.
+         * @return True if they overlap.
+         */
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const{
+            if constexpr (std::is_same_v<V, Type>){
+                const Type *p = m_data;
+                return Impl::overlaps(p, p + index(R - 1, C - 1) + 1, begin, end);
+            }
+            else{
+                return false;
+            }
+        }
+
+        /**
+         * @brief Evaluation expressions and return as a matrix instance.
+         *        See `Matrix::eval()`.
+         * @param Evaluated matrix (reference output)
+         */
+        template <typename M> requires is_equal_type_size_v<M, Map>
+        void eval(M &_result) const{
+            Impl::evaluate(_result, *this);
+        }
+
+    private:
+        T *m_data;
+        Index m_outer_stride;
+        Index m_inner_stride;
+    };
+
+    /**
+     * @brief Specialization of `nested` which stores views by value, since
+     *        they are as small as a reference and often temporaries (e.g.,
+     *        `mat.row(0) + mat.row(1)`).
+     */
+    template<typename T, Index R, Index C, Layout L>
+    struct nested<Map<T, R, C, L>>{
+        using type = const Map<T, R, C, L>;
+    };
+}
@@ -32,11 +32,16 @@
 #include <type_traits>
 #include <cmath>
 #include <cstring>
+#include <utility>
 #include <vector>
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/map.h>
+#include <Peanut/impl/matrix_eval.h>
+#include <Peanut/impl/matrix_storage.h>
 #include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
 
 // Dependencies headers
 
@@ -69,6 +74,24 @@ namespace Peanut {
         INLINE auto operator()(Index r, Index c) const{
             return static_cast<const E&>(*this)(r, c);
         }
+
+        /**
+         * @brief Get a row size of the expression. It equals to `E::Row`
+         *        unless it is `Dynamic`.
+         * @return Row size.
+         */
+        INLINE Index rows() const{
+            return static_cast<const E&>(*this).rows();
+        }
+
+        /**
+         * @brief Get a column size of the expression. It equals to `E::Col`
+         *        unless it is `Dynamic`.
+         * @return Column size.
+         */
+        INLINE Index cols() const{
+            return static_cast<const E&>(*this).cols();
+        }
     };
 
     /**
@@ -76,9 +99,16 @@ namespace Peanut {
      * @tparam T Data type.
      * @tparam R Row size.
      * @tparam C Column size.
+     * @tparam S Storage policy. See `Storage`.
+     * @tparam LD Leading dimension (i.e., row pitch, or column pitch for
+     *            `Layout::ColMajor`) in elements. 0 means that rows (columns)
+     *            are packed without padding. See `padded_ld_v` to start every
+     *            row on a vector boundary.
+     * @tparam L Storage order of elements. See `Layout`.
      */
-    template<typename T, Index R, Index C> requires std::is_arithmetic_v<T> && (R > 0) && (C > 0)
-    struct Matrix : public MatrixExpr<Matrix<T, R, C>>{
+    template<typename T, Index R, Index C, Storage S = Storage::Auto, Index LD = 0, Layout L = Layout::RowMajor>
+        requires std::is_arithmetic_v<T> && (R > 0) && (C > 0) && (LD == 0 || LD >= (L == Layout::RowMajor ? C : R))
+    struct Matrix : public MatrixExpr<Matrix<T, R, C, S, LD, L>>{
 
         /**
          * @brief Data type. See the detailed description of \p MatrixExpr.
@@ -95,6 +125,59 @@ namespace Peanut {
          */
         static constexpr Index Col = C;
 
+        /**
+         * @brief Storage order of elements in `m_data`.
+         */
+        static constexpr Layout StorageOrder = L;
+
+        /**
+         * @brief Elements are referred directly. See `is_leaf`.
+         */
+        static constexpr bool Leaf = true;
+
+        /**
+         * @brief Distance between the first elements of adjacent rows
+         *        (columns for `Layout::ColMajor`) in `m_data`.
+         */
+        static constexpr Index Stride = (LD != 0) ? LD : (L == Layout::RowMajor ? C : R);
+
+        /**
+         * @brief Number of elements allocated in `m_data`, including padding.
+         */
+        static constexpr Index Size = (L == Layout::RowMajor ? R : C) * Stride;
+
+        /**
+         * @brief True if elements are stored without padding, so that they
+         *        can be accessed by `coeff()`. See `is_linear`.
+         */
+        static constexpr bool Linear = (Stride == (L == Layout::RowMajor ? C : R));
+
+        /**
+         * @brief True if elements can be loaded as SIMD packets. See `is_vectorizable`.
+         */
+        static constexpr bool Vectorizable = Linear && Impl::has_packet_v<T>;
+
+        /**
+         * @brief True if `m_data` is aligned to `Impl::Packet<T>`, so that
+         *        packets can be loaded and stored by aligned instructions.
+         */
+        static constexpr bool PacketAligned = Impl::storage_t<T, Size, S>::Alignment >= sizeof(Impl::Packet<T>);
+
+        /**
+         * @brief Position of the element in \p r 'th row and \p c 'th column in `m_data`.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Index of `m_data`.
+         */
+        INLINE static constexpr Index index(Index r, Index c){
+            if constexpr (L == Layout::RowMajor){
+                return r*Stride+c;
+            }
+            else{
+                return c*Stride+r;
+            }
+        }
+
         /**
          * @brief Constructor without any initialization
          */
@@ -114,35 +197,146 @@ namespace Peanut {
         template <typename ...TList>
             requires std::conjunction_v<std::is_same<T, TList>...> &&
                      (sizeof...(TList) == Row*Col)
-        Matrix(TList ... tlist) : m_data{std::forward<T>(tlist)...} {}
+        Matrix(TList ... tlist) {
+            const T elems[] = {tlist...};
+            copy_rows(elems);
+        }
 
         /**
          * @brief Constructor with std::array.
+         * @details Elements are given in the storage order of the matrix
+         *          (i.e., column-major for `Layout::ColMajor`), without padding.
          * @param data A std::array having `T` type and \p R * \p C size.
          */
         explicit Matrix(const std::array<T, R * C> &data) {
-            memcpy(m_data.data(), data.data(), sizeof(T)*R*C);
+            copy_packed(data.data());
         }
 
         /**
          * @brief Constructor with std::vector.
+         * @details Elements are given in the storage order of the matrix
+         *          (i.e., column-major for `Layout::ColMajor`), without padding.
          * @param data std::vector having `T` type.
          */
-        explicit Matrix(const std::vector<T> &data) : m_data{data} {}
+        explicit Matrix(const std::vector<T> &data) {
+            assert(data.size() == R * C);
+            copy_packed(data.data());
+        }
 
         /**
          * @brief Constructor from arbitrary Peanut matrix expression.
          * @details Lazy evaluation is performed when the given expression is
          *          substituted to other `Matrix`, or `Matrix::eval()` is called.
+         *          Elements are evaluated in the storage order of the matrix.
+         *          If the size of \p expr is `Dynamic`, it is checked in runtime.
          * @param expr Arbitrary Peanut matrix expression.
          */
         template<typename E>
         Matrix(const MatrixExpr<E> &expr) requires is_equal_type_size_v<E, Matrix>{
-            for(Index r=0;r< R;r++){
-                for(Index c=0;c< C;c++){
-                    m_data[r*C+c] = expr(r, c);
+            Impl::check_equal_size(*this, static_cast<const E&>(expr));
+            static_cast<const E&>(expr).eval(*this);
+        }
+
+        /**
+         * @brief Evaluate arbitrary Peanut matrix expression into the matrix.
+         * @details If \p expr reads elements of this matrix (See `aliases()`),
+         *          it is evaluated into a temporary matrix first. It is skipped
+         *          at compile-time if \p expr is element-wise and linearly
+         *          accessible (See `is_linear`), since every element is read
+         *          before it is written. Use `noalias()` to skip it explicitly.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        Matrix &operator=(const MatrixExpr<E> &expr) requires is_equal_type_size_v<E, Matrix>{
+            const E &e = static_cast<const E&>(expr);
+            Impl::check_equal_size(*this, e);
+            if constexpr (!is_linear_pair_v<Matrix, E>){
+                const T *p = std::as_const(m_data).data();
+                if(e.aliases(p, p + Size)){
+                    *this = Matrix(e);
+                    return *this;
                 }
             }
+            e.eval(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Get a proxy of the matrix whose assignment does not check
+         *        aliasing.
+         *
+         *     mat.noalias() = a * b + c;
+         *
+         * @return `Impl::NoAlias` instance referring this matrix.
+         */
+        INLINE Impl::NoAlias<Matrix> noalias(){
+            return {*this};
+        }
+
+        /**
+         * @brief Add arbitrary Peanut matrix expression to the matrix in place,
+         *        without a temporary matrix. See `Impl::compound_assign()`.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        Matrix &operator+=(const MatrixExpr<E> &expr) requires is_equal_type_size_v<E, Matrix>{
+            const T *p = std::as_const(m_data).data();
+            Impl::compound_assign(*this, static_cast<const E&>(expr), p, p + Size,
+                                  [](const auto &x, const auto &y){ return x + y; });
+            return *this;
+        }
+
+        /**
+         * @brief Subtract arbitrary Peanut matrix expression from the matrix
+         *        in place, without a temporary matrix. See `Impl::compound_assign()`.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        Matrix &operator-=(const MatrixExpr<E> &expr) requires is_equal_type_size_v<E, Matrix>{
+            const T *p = std::as_const(m_data).data();
+            Impl::compound_assign(*this, static_cast<const E&>(expr), p, p + Size,
+                                  [](const auto &x, const auto &y){ return x - y; });
+            return *this;
+        }
+
+        /**
+         * @brief Multiply the matrix by square Peanut matrix expression in
+         *        place, using a single scratch row instead of a temporary
+         *        matrix. See `Impl::multiply_assign()`.
+         * @param expr Square Peanut matrix expression.
+         * @return Reference of this instance.
+         */
+        template<typename E>
+        Matrix &operator*=(const MatrixExpr<E> &expr)
+            requires is_equal_type_v<E, Matrix> && is_square_v<E> && (E::Row == C || E::Row == Dynamic){
+            const T *p = std::as_const(m_data).data();
+            Impl::multiply_assign(*this, static_cast<const E&>(expr), p, p + Size);
+            return *this;
+        }
+
+        /**
+         * @brief Multiply the matrix by scalar in place. It is available if
+         *        `operator*()` keeps the type, i.e., integral or `Float` type.
+         * @param scalar Scalar value.
+         * @return Reference of this instance.
+         */
+        Matrix &operator*=(T scalar) requires (!std::is_floating_point_v<T> || std::is_same_v<T, Float>){
+            (std::as_const(*this) * scalar).eval(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Divide the matrix by scalar in place. It is available for
+         *        `Float` type matrix, as `operator/()` evaluates to `Float`.
+         * @param scalar Scalar value.
+         * @return Reference of this instance.
+         */
+        Matrix &operator/=(T scalar) requires std::is_same_v<T, Float>{
+            (std::as_const(*this) / scalar).eval(*this);
+            return *this;
         }
 
         /**
@@ -151,7 +345,7 @@ namespace Peanut {
          */
         static Matrix zeros() {
             auto m = Matrix();
-            memset(m.m_data.data(), 0, sizeof(T)*R*C);
+            memset(m.m_data.data(), 0, sizeof(T)*Size);
             return m;
         }
 
@@ -161,9 +355,9 @@ namespace Peanut {
          */
         static Matrix identity() requires is_square_v<Matrix> {
             Matrix a;
-            memset(a.m_data.data(), 0, sizeof(T)*R*C);
+            memset(a.m_data.data(), 0, sizeof(T)*Size);
             for (Index i = 0; i < R; i++) {
-                a.m_data[i*C+i] = t_1;
+                a.m_data[index(i, i)] = t_1;
             }
             return a;
         }
@@ -188,10 +382,9 @@ namespace Peanut {
                      (sizeof...(RList) == Row)
         static Matrix from_rows(RList ... rlist){
             Matrix ret;
-            int idx = 0;
-            constexpr size_t copy_byte = sizeof(Type) * Col;
-            for(const Matrix<Type, 1, Col> p : {rlist...}){
-                memcpy(&(ret.m_data[idx*C]), p.m_data.data(), copy_byte);
+            Index idx = 0;
+            for(const Matrix<Type, 1, Col> &p : {rlist...}){
+                ret.set_row(idx, p);
                 idx++;
             }
             return ret;
@@ -217,17 +410,31 @@ namespace Peanut {
             requires std::conjunction_v<std::is_same<Matrix<Type, Row, 1>, CList>...> &&
                      (sizeof...(CList) == Col)
         static Matrix from_cols(CList ... clist){
-            Matrix<Type, Row, Col> ret;
-            int c = 0;
-            for(const Matrix<Type, Row, 1> p : {clist...}){
-                for(int r=0;r<Row;r++){
-                    ret.m_data[r*C+c] = p.m_data[r];
-                }
-                c++;
+            Matrix ret;
+            Index idx = 0;
+            for(const Matrix<Type, Row, 1> &p : {clist...}){
+                ret.set_col(idx, p);
+                idx++;
             }
             return ret;
         }
 
+        /**
+         * @brief Implementation of `MatrixExpr::rows()`.
+         * @return \p R
+         */
+        INLINE static constexpr Index rows(){
+            return R;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::cols()`.
+         * @return \p C
+         */
+        INLINE static constexpr Index cols(){
+            return C;
+        }
+
         /**
          * @brief Implementation of `MatrixExpr::operator()` which returns rvalue.
          * @param r Row index.
@@ -235,7 +442,36 @@ namespace Peanut {
          * @return Rvalue of an element in \p r 'th Row and \p c 'th column.
          */
         INLINE T operator()(Index r, Index c) const{
-            return m_data[r*C+c];
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Get an element by a flat index in the storage order.
+         *        Available only if the matrix is not padded.
+         * @param i Flat index.
+         * @return Rvalue of `m_data[i]`.
+         */
+        INLINE T coeff(Index i) const requires Linear{
+            return m_data[i];
+        }
+
+        /**
+         * @brief Load SIMD packet of elements from a flat index in the
+         *        storage order. See `coeff()`.
+         * @param i Flat index of the first element.
+         * @tparam Aligned True if \p i is a multiple of the packet size, so
+         *                 that the packet is loaded by an aligned instruction
+         *                 if `PacketAligned` is true.
+         * @return `Impl::Packet<T>` instance.
+         */
+        template <bool Aligned = false>
+        INLINE Impl::Packet<T> packet(Index i) const requires Vectorizable{
+            if constexpr (Aligned && PacketAligned){
+                return Impl::Packet<T>::load_aligned(&(m_data[i]));
+            }
+            else{
+                return Impl::Packet<T>::load(&(m_data[i]));
+            }
         }
 
         /**
@@ -247,7 +483,7 @@ namespace Peanut {
          * @return Reference of an element in \p r 'th Row and \p c 'th column.
          */
         INLINE T& operator()(Index r, Index c) {
-            return m_data[r*C+c];
+            return m_data[index(r, c)];
         }
 
         /**
@@ -257,7 +493,14 @@ namespace Peanut {
          */
         Matrix<Type, 1, Col> get_row(Index idx) const{
             Matrix<Type, 1, Col> ret;
-            memcpy(ret.m_data.data(), &(m_data[idx*C]), sizeof(Type)*Col);
+            if constexpr (L == Layout::RowMajor){
+                memcpy(ret.m_data.data(), &(m_data[index(idx, 0)]), sizeof(Type)*Col);
+            }
+            else{
+                for(Index i=0;i<Col;i++){
+                    ret.m_data[i] = m_data[index(idx, i)];
+                }
+            }
             return ret;
         }
 
@@ -267,7 +510,14 @@ namespace Peanut {
          * @param row Row matrix which will be assigned to the r'th row of the matrix.
          */
         void set_row(Index idx, const Matrix<Type, 1, Col> &row){
-            memcpy(&(m_data[idx*C]), row.m_data.data(), sizeof(Type)*Col);
+            if constexpr (L == Layout::RowMajor){
+                memcpy(&(m_data[index(idx, 0)]), row.m_data.data(), sizeof(Type)*Col);
+            }
+            else{
+                for(Index i=0;i<Col;i++){
+                    m_data[index(idx, i)] = row.m_data[i];
+                }
+            }
         }
 
         /**
@@ -277,8 +527,13 @@ namespace Peanut {
          */
         Matrix<Type, Row, 1> get_col(Index idx) const{
             Matrix<Type, Row, 1> ret;
-            for(int i=0;i<Row;i++){
-                ret.m_data[i] = m_data[i*C+idx];
+            if constexpr (L == Layout::ColMajor){
+                memcpy(ret.m_data.data(), &(m_data[index(0, idx)]), sizeof(Type)*Row);
+            }
+            else{
+                for(Index i=0;i<Row;i++){
+                    ret.m_data[i] = m_data[index(i, idx)];
+                }
             }
             return ret;
         }
@@ -289,8 +544,116 @@ namespace Peanut {
          * @param row Column matrix which will be assigned to the idx'th column of the matrix.
          */
         void set_col(Index idx, const Matrix<Type, Row, 1> &col){
-            for(int i=0;i<Row;i++){
-                m_data[i*C+idx] = col.m_data[i];
+            if constexpr (L == Layout::ColMajor){
+                memcpy(&(m_data[index(0, idx)]), col.m_data.data(), sizeof(Type)*Row);
+            }
+            else{
+                for(Index i=0;i<Row;i++){
+                    m_data[index(i, idx)] = col.m_data[i];
+                }
+            }
+        }
+
+        // ===================== Strided views begins =====================
+
+        /**
+         * @brief Writable view of a \p idx 'th row. Any matrix expression of
+         *        size `1 x Col` can be assigned to it, and it can be used as an
+         *        operand without copying the row.
+         *
+         *     mat.row(0) = mat.row(0) - mat.row(1) * 2;
+         *
+         * @param idx Row index.
+         * @return `Map` instance referring the row of this matrix.
+         */
+        INLINE Map<T, 1, C, L> row(Index idx){
+            assert(idx < R);
+            return Map<T, 1, C, L>(&(m_data[index(idx, 0)]), Stride);
+        }
+
+        /**
+         * @brief Read-only view of a \p idx 'th row. See `row()`.
+         * @param idx Row index.
+         * @return `Map` instance referring the row of this matrix.
+         */
+        INLINE Map<const T, 1, C, L> row(Index idx) const{
+            assert(idx < R);
+            return Map<const T, 1, C, L>(&(m_data[index(idx, 0)]), Stride);
+        }
+
+        /**
+         * @brief Writable view of a \p idx 'th column. See `row()`.
+         * @param idx Column index.
+         * @return `Map` instance referring the column of this matrix.
+         */
+        INLINE Map<T, R, 1, L> col(Index idx){
+            assert(idx < C);
+            return Map<T, R, 1, L>(&(m_data[index(0, idx)]), Stride);
+        }
+
+        /**
+         * @brief Read-only view of a \p idx 'th column. See `row()`.
+         * @param idx Column index.
+         * @return `Map` instance referring the column of this matrix.
+         */
+        INLINE Map<const T, R, 1, L> col(Index idx) const{
+            assert(idx < C);
+            return Map<const T, R, 1, L>(&(m_data[index(0, idx)]), Stride);
+        }
+
+        /**
+         * @brief Writable view of a \p row_size x \p col_size block whose
+         *        upper-left element is (\p r, \p c). Unlike `Block()`, the
+         *        offset may be given in runtime.
+         *
+         *     mat.block<2, 2>(1, 1) = Matrix<float, 2, 2>::identity();
+         *
+         * @tparam row_size Row size of the block.
+         * @tparam col_size Column size of the block.
+         * @param r Row index of the upper-left element.
+         * @param c Column index of the upper-left element.
+         * @return `Map` instance referring the block of this matrix.
+         */
+        template<Index row_size, Index col_size>
+            requires (0 < row_size && row_size <= R && 0 < col_size && col_size <= C)
+        INLINE Map<T, row_size, col_size, L> block(Index r, Index c){
+            assert(r + row_size <= R && c + col_size <= C);
+            return Map<T, row_size, col_size, L>(&(m_data[index(r, c)]), Stride);
+        }
+
+        /**
+         * @brief Read-only view of a block. See `block()`.
+         * @tparam row_size Row size of the block.
+         * @tparam col_size Column size of the block.
+         * @param r Row index of the upper-left element.
+         * @param c Column index of the upper-left element.
+         * @return `Map` instance referring the block of this matrix.
+         */
+        template<Index row_size, Index col_size>
+            requires (0 < row_size && row_size <= R && 0 < col_size && col_size <= C)
+        INLINE Map<const T, row_size, col_size, L> block(Index r, Index c) const{
+            assert(r + row_size <= R && c + col_size <= C);
+            return Map<const T, row_size, col_size, L>(&(m_data[index(r, c)]), Stride);
+        }
+
+        // ====================== Strided views ends =======================
+
+        /**
+         * @brief Check if elements of the matrix overlap the memory [\p begin, \p end).
+         *        It is used to detect aliasing in assignment, and is false for
+         *        different element types at compile-time.
+         * @param begin Pointer to the first element of the memory.
+         * @param end Pointer past the last element of the memory.
+         * @return True if they overlap.
+         */
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const{
+            if constexpr (std::is_same_v<V, T>){
+                const T *p = std::as_const(m_data).data();
+                return Impl::overlaps(p, p + Size, begin, end);
+            }
+            else{
+                return false;
             }
         }
 
@@ -299,9 +662,32 @@ namespace Peanut {
          *        Note that every matrix expression classes must implement this
          *        method even though it is not a method of `MatrixExpr`.
          * @param Evaluated matrix (reference output)
+         * @tparam M Type of the evaluated matrix, which may have different
+         *           storage policy, leading dimension or layout.
          */
-        void eval(Matrix<Type, Row, Col> &_result) const{
-            _result.m_data = m_data;
+        template <typename M> requires is_equal_type_size_v<M, Matrix>
+        void eval(M &_result) const{
+            if constexpr (!is_fixed_size_v<M>){
+                _result.resize(R, C);
+            }
+            if constexpr (std::is_same_v<M, Matrix>){
+                // O(1) for `Storage::Shared`
+                _result = *this;
+            }
+            else if constexpr (requires { M::Stride; } && M::StorageOrder == L){
+                constexpr Index outer = (L == Layout::RowMajor) ? R : C;
+                constexpr Index inner = (L == Layout::RowMajor) ? C : R;
+                for(Index o=0;o<outer;o++){
+                    const Index r = (L == Layout::RowMajor) ? o : 0;
+                    const Index c = (L == Layout::RowMajor) ? 0 : o;
+                    memcpy(&_result(r, c), &(m_data[index(r, c)]), sizeof(T)*inner);
+                }
+            }
+            else{
+                for_each_index_sized<M::StorageOrder, R, C>(R, C, [&](Index r, Index c){
+                    _result(r, c) = m_data[index(r, c)];
+                });
+            }
         }
 
         // =============== Features for vector usage begins ================
@@ -314,7 +700,7 @@ namespace Peanut {
          */
         INLINE T operator[](Index i) const
             requires (Row==1) || (Col==1){
-            return m_data[i];
+            return m_data[Row == 1 ? index(0, i) : index(i, 0)];
         }
 
         /**
@@ -325,7 +711,7 @@ namespace Peanut {
          */
         INLINE T& operator[](Index i)
             requires (Row==1) || (Col==1){
-            return m_data[i];
+            return m_data[Row == 1 ? index(0, i) : index(i, 0)];
         }
 
         /**
@@ -337,7 +723,7 @@ namespace Peanut {
         T dot(const Matrix &vec) const requires (Row==1) || (Col==1){
             T ret = t_0;
             for(int i=0;i<Row*Col;i++){
-                ret += (vec.m_data[i] * m_data[i]);
+                ret += (vec[i] * (*this)[i]);
             }
             return ret;
         }
@@ -350,7 +736,7 @@ namespace Peanut {
         Float length() const requires (Row==1) || (Col==1){
             T ret = t_0;
             for(int i=0;i<Row*Col;i++){
-                ret += (m_data[i] * m_data[i]);
+                ret += ((*this)[i] * (*this)[i]);
             }
             return std::sqrt(ret);
         }
@@ -375,7 +761,11 @@ namespace Peanut {
          * @return Max element in the vector.
          */
         T max() const requires (Row==1) || (Col==1){
-            return *std::max_element(m_data.begin(), m_data.end());
+            T ret = (*this)[0];
+            for(int i=1;i<Row*Col;i++){
+                ret = std::max(ret, (*this)[i]);
+            }
+            return ret;
         }
 
         /**
@@ -384,7 +774,11 @@ namespace Peanut {
          * @return Min element in the vector.
          */
         T min() const requires (Row==1) || (Col==1){
-            return *std::min_element(m_data.begin(), m_data.end());
+            T ret = (*this)[0];
+            for(int i=1;i<Row*Col;i++){
+                ret = std::min(ret, (*this)[i]);
+            }
+            return ret;
         }
 
         /**
@@ -419,8 +813,10 @@ namespace Peanut {
          * @return Given std::ostream
          */
         friend std::ostream &operator<<(std::ostream &os, const Matrix &matrix) {
-            for(int i=0;i< R * C;i++){
-                os << matrix.m_data[i]<<" ";
+            for(Index r=0;r< R;r++){
+                for(Index c=0;c< C;c++){
+                    os << matrix(r, c)<<" ";
+                }
             }
             return os;
         }
@@ -434,9 +830,7 @@ namespace Peanut {
          * @param scalar Scalar which will be multiplied to \p r2 'th Row.
          */
         void subtract_row(Index r1, Index r2, T scalar){
-            for(int i=0;i< C;i++){
-                (*this)(r1, i) -= scalar * (*this)(r2, i);
-            }
+            row(r1) -= row(r2) * scalar;
         }
 
         /**
@@ -471,7 +865,7 @@ namespace Peanut {
                 return m_data[0];
             }
             else if constexpr (C ==2){
-                return m_data[0] * m_data[C+1] - m_data[1] * m_data[C];
+                return (*this)(0, 0) * (*this)(1, 1) - (*this)(0, 1) * (*this)(1, 0);
             }
             else{
                 T ret = static_cast<T>(0);
@@ -479,7 +873,7 @@ namespace Peanut {
                 for_<C>([&] (auto c) {
                     Matrix<T, R-1, C-1> submat;
                     SubMat<0, c.value>(*this).eval(submat);
-                    ret += (c.value % 2 ? -1 : 1) * m_data[c.value] * submat.det();
+                    ret += (c.value % 2 ? -1 : 1) * (*this)(0, c.value) * submat.det();
                 });
                 return ret;
             }
@@ -506,15 +900,88 @@ namespace Peanut {
             return det;
         }
 
-        // Matrix data
-        std::array<T, R*C> m_data;
-        // union {
-        //     std::array<T, R * C> d1;
-        //     T d2[R][C];
-        // } m_data;
+        // Matrix data, stored inline or on the heap depending on `S`.
+        // Element (r, c) is located at `m_data[index(r, c)]`.
+        Impl::storage_t<T, Size, S> m_data;
 
     private:
+        /**
+         * @brief Copy row-major packed \p R * \p C elements into `m_data`.
+         * @param src Pointer to the first element.
+         */
+        void copy_rows(const T *src){
+            if constexpr (L == Layout::RowMajor){
+                copy_packed(src);
+            }
+            else{
+                for_each_index_sized<L, R, C>(R, C, [&](Index r, Index c){
+                    m_data[index(r, c)] = src[r*C+c];
+                });
+            }
+        }
+
+        /**
+         * @brief Copy \p R * \p C elements packed in the storage order into `m_data`.
+         * @param src Pointer to the first element.
+         */
+        void copy_packed(const T *src){
+            constexpr Index outer = (L == Layout::RowMajor) ? R : C;
+            constexpr Index inner = (L == Layout::RowMajor) ? C : R;
+            if constexpr (Stride == inner){
+                memcpy(m_data.data(), src, sizeof(T)*R*C);
+            }
+            else{
+                for(Index o=0;o<outer;o++){
+                    memcpy(&(m_data[o*Stride]), src + o*inner, sizeof(T)*inner);
+                }
+            }
+        }
+
+
         static constexpr T t_1 = static_cast<T>(1);
         static constexpr T t_0 = static_cast<T>(0);
     };
+
+    /**
+     * @brief Matrix whose rows are padded to start on a SIMD register boundary,
+     *        and whose row pitch avoids cache-set aliasing.
+     *        See `padded_ld` and `aliasing_free_ld`.
+     * @tparam T Data type.
+     * @tparam R Row size.
+     * @tparam C Column size.
+     * @tparam S Storage policy. See `Storage`.
+     */
+    template<typename T, Index R, Index C, Storage S = Storage::Auto>
+    using PaddedMatrix = Matrix<T, R, C, S, aliasing_free_ld_v<T, padded_ld_v<T, C>>>;
+
+    /**
+     * @brief Matrix whose elements are stored in column-major order.
+     * @tparam T Data type.
+     * @tparam R Row size.
+     * @tparam C Column size.
+     * @tparam S Storage policy. See `Storage`.
+     */
+    template<typename T, Index R, Index C, Storage S = Storage::Auto>
+    using ColMajorMatrix = Matrix<T, R, C, S, 0, Layout::ColMajor>;
+
+    /**
+     * @brief Matrix whose copies share elements until one of them is
+     *        modified. See `Storage::Shared`.
+     * @tparam T Data type.
+     * @tparam R Row size.
+     * @tparam C Column size.
+     */
+    template<typename T, Index R, Index C>
+    using SharedMatrix = Matrix<T, R, C, Storage::Shared>;
+
+    /**
+     * @brief Specialization of `eval_type` which keeps `Storage::Shared`
+     *        matrices as they are, so that temporaries evaluated from them
+     *        (e.g., to resolve aliasing in assignment) share the elements
+     *        instead of copying them.
+     */
+    template<typename T, Index R, Index C, Index LD, Layout L>
+    struct eval_type<Matrix<T, R, C, Storage::Shared, LD, L>, true>{
+        using type = Matrix<T, R, C, Storage::Shared, LD, L>;
+    };
 }
@@ -0,0 +1,536 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix.h>
+#include <Peanut/impl/matrix_storage.h>
+#include <Peanut/impl/matrix_type_traits.h>
+
+// Dependencies headers
+
+namespace Peanut {
+
+    /**
+     * @brief Container of \p N matrices of the same size, stored
+     *        lane-interleaved (i.e., element (r, c) of every matrix is
+     *        contiguous). Operations are evaluated for all matrices at once
+     *        with the innermost loop over the \p N lanes, so that the
+     *        compiler can vectorize them.
+     * @details Unlike `Matrix`, operations on `MatrixBatch` are evaluated
+     *          eagerly, since each element of a batch is a lane array rather
+     *          than a scalar.
+     *
+     *     std::array<Peanut::Matrix<float, 3, 3>, 8> mats = ...;
+     *     auto batch = Peanut::MatrixBatch<float, 3, 3, 8>::gather(mats);
+     *     auto inv = Peanut::Inverse(batch);
+     *     auto dets = batch.det();
+     *     (batch * inv).scatter(mats);
+     *
+     * @tparam T Type of elements.
+     * @tparam R Row size of each matrix.
+     * @tparam C Column size of each matrix.
+     * @tparam N Number of matrices (lanes).
+     */
+    template<typename T, Index R, Index C, Index N>
+        requires std::is_arithmetic_v<T> && (R > 0) && (C > 0) && (N > 0)
+    struct MatrixBatch{
+
+        /**
+         * @brief Data type.
+         */
+        using Type = T;
+
+        /**
+         * @brief Row size of each matrix.
+         */
+        static constexpr Index Row = R;
+
+        /**
+         * @brief Column size of each matrix.
+         */
+        static constexpr Index Col = C;
+
+        /**
+         * @brief Number of matrices.
+         */
+        static constexpr Index Lanes = N;
+
+        /**
+         * @brief Number of elements in `m_data`.
+         */
+        static constexpr Index Size = R*C*N;
+
+        /**
+         * @brief Position of the element in \p r 'th row and \p c 'th column
+         *        of the first matrix in `m_data`. Other matrices follow it.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Index of `m_data`.
+         */
+        INLINE static constexpr Index index(Index r, Index c){
+            return (r*C + c)*N;
+        }
+
+        /**
+         * @brief Constructor without any initialization
+         */
+        MatrixBatch() {}
+
+        /**
+         * @brief Construct a batch whose matrices are all zero.
+         * @return Zero batch.
+         */
+        static MatrixBatch zeros() {
+            MatrixBatch b;
+            memset(b.m_data.data(), 0, sizeof(T)*Size);
+            return b;
+        }
+
+        /**
+         * @brief Construct a batch whose matrices are all identity.
+         * @return Identity batch.
+         */
+        static MatrixBatch identity() requires (R == C) {
+            MatrixBatch b = zeros();
+            for(Index i=0;i<R;i++){
+                T *dst = b.lanes(i, i);
+                for(Index k=0;k<N;k++){
+                    dst[k] = static_cast<T>(1);
+                }
+            }
+            return b;
+        }
+
+        /**
+         * @brief Gather \p N matrices into a batch.
+         * @param mats Pointer to \p N contiguous matrices.
+         * @return Constructed batch.
+         */
+        template<Storage S, Index LD, Layout L>
+        static MatrixBatch gather(const Matrix<T, R, C, S, LD, L> *mats) {
+            MatrixBatch b;
+            for(Index k=0;k<N;k++){
+                b.set(k, mats[k]);
+            }
+            return b;
+        }
+
+        /**
+         * @brief Gather \p N matrices into a batch.
+         * @param mats std::array of \p N matrices.
+         * @return Constructed batch.
+         */
+        template<Storage S, Index LD, Layout L>
+        static MatrixBatch gather(const std::array<Matrix<T, R, C, S, LD, L>, N> &mats) {
+            return gather(mats.data());
+        }
+
+        /**
+         * @brief Scatter matrices of the batch into \p N matrices.
+         * @param mats Pointer to \p N contiguous matrices.
+         */
+        template<Storage S, Index LD, Layout L>
+        void scatter(Matrix<T, R, C, S, LD, L> *mats) const {
+            for(Index k=0;k<N;k++){
+                for(Index r=0;r<R;r++){
+                    for(Index c=0;c<C;c++){
+                        mats[k](r, c) = m_data[index(r, c) + k];
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Scatter matrices of the batch into \p N matrices.
+         * @param mats std::array of \p N matrices.
+         */
+        template<Storage S, Index LD, Layout L>
+        void scatter(std::array<Matrix<T, R, C, S, LD, L>, N> &mats) const {
+            scatter(mats.data());
+        }
+
+        /**
+         * @brief Get \p k 'th matrix of the batch.
+         * @param k Lane index.
+         * @return `Matrix` instance.
+         */
+        Matrix<T, R, C> get(Index k) const {
+            Matrix<T, R, C> ret;
+            for(Index r=0;r<R;r++){
+                for(Index c=0;c<C;c++){
+                    ret(r, c) = m_data[index(r, c) + k];
+                }
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Set \p k 'th matrix of the batch by evaluating arbitrary
+         *        Peanut matrix expression.
+         * @param k Lane index.
+         * @param expr Arbitrary Peanut matrix expression.
+         */
+        template<typename E> requires is_equal_type_size_v<E, Matrix<T, R, C>> && is_fixed_size_v<E>
+        void set(Index k, const MatrixExpr<E> &expr) {
+            const E &e = static_cast<const E&>(expr);
+            for(Index r=0;r<R;r++){
+                for(Index c=0;c<C;c++){
+                    m_data[index(r, c) + k] = e(r, c);
+                }
+            }
+        }
+
+        /**
+         * @brief Get an element in \p r 'th row and \p c 'th column of
+         *        \p k 'th matrix.
+         * @param r Row index.
+         * @param c Column index.
+         * @param k Lane index.
+         * @return Rvalue of the element.
+         */
+        INLINE T operator()(Index r, Index c, Index k) const{
+            return m_data[index(r, c) + k];
+        }
+
+        /**
+         * @brief Get a reference of an element in \p r 'th row and \p c 'th
+         *        column of \p k 'th matrix.
+         * @param r Row index.
+         * @param c Column index.
+         * @param k Lane index.
+         * @return Reference of the element.
+         */
+        INLINE T& operator()(Index r, Index c, Index k){
+            return m_data[index(r, c) + k];
+        }
+
+        /**
+         * @brief Get \p N contiguous elements in \p r 'th row and \p c 'th
+         *        column of every matrix.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Pointer to the element of the first matrix.
+         */
+        INLINE T *lanes(Index r, Index c){
+            return &(m_data[index(r, c)]);
+        }
+
+        /**
+         * @brief Read-only version of `lanes()`.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Pointer to the element of the first matrix.
+         */
+        INLINE const T *lanes(Index r, Index c) const{
+            return &(m_data[index(r, c)]);
+        }
+
+        /**
+         * @brief Calculate determinants of every matrix by cofactor
+         *        expansion, as `Matrix::det()` does.
+         * @return Determinant of each matrix.
+         */
+        std::array<T, N> det() const requires (R == C){
+            std::array<T, N> ret;
+            if constexpr (C == 1){
+                memcpy(ret.data(), lanes(0, 0), sizeof(T)*N);
+            }
+            else if constexpr (C == 2){
+                const T *a = lanes(0, 0), *b = lanes(0, 1), *c = lanes(1, 0), *d = lanes(1, 1);
+                for(Index k=0;k<N;k++){
+                    ret[k] = a[k]*d[k] - b[k]*c[k];
+                }
+            }
+            else{
+                ret.fill(static_cast<T>(0));
+                for_<C>([&] (auto c) {
+                    const auto sub = minor<0, c.value>().det();
+                    const T *a = lanes(0, c.value);
+                    for(Index k=0;k<N;k++){
+                        if constexpr (c.value % 2){
+                            ret[k] -= a[k] * sub[k];
+                        }
+                        else{
+                            ret[k] += a[k] * sub[k];
+                        }
+                    }
+                });
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Get a batch of submatrices without \p row_ex 'th row and
+         *        \p col_ex 'th column. See `SubMat()`.
+         * @tparam row_ex Row index to be excluded.
+         * @tparam col_ex Column index to be excluded.
+         * @return Batch of submatrices.
+         */
+        template<Index row_ex, Index col_ex>
+            requires (R > 1) && (C > 1) && (row_ex < R) && (col_ex < C)
+        auto minor() const{
+            MatrixBatch<T, R-1, C-1, N> ret;
+            for(Index r=0;r<R-1;r++){
+                for(Index c=0;c<C-1;c++){
+                    memcpy(ret.lanes(r, c),
+                           lanes(r < row_ex ? r : r + 1, c < col_ex ? c : c + 1),
+                           sizeof(T)*N);
+                }
+            }
+            return ret;
+        }
+
+        // =============== Features for vector usage begins ================
+
+        /**
+         * @brief Dot product of every pair of vectors.
+         * @param vec Batch of vectors.
+         * @return Dot product of each pair.
+         */
+        std::array<T, N> dot(const MatrixBatch &vec) const requires (R==1) || (C==1){
+            std::array<T, N> ret;
+            ret.fill(static_cast<T>(0));
+            for(Index i=0;i<R*C;i++){
+                const T *a = &(m_data[i*N]);
+                const T *b = &(vec.m_data[i*N]);
+                for(Index k=0;k<N;k++){
+                    ret[k] += a[k] * b[k];
+                }
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Cross product of every pair of 3D vectors.
+         * @param m1 Batch of vectors.
+         * @param m2 Batch of vectors.
+         * @return Batch of cross products.
+         */
+        static MatrixBatch cross(const MatrixBatch &m1, const MatrixBatch &m2)
+            requires (R==1 && C==3) || (R==3 && C==1){
+            MatrixBatch ret;
+            for(Index i=0;i<3;i++){
+                const Index j = (i + 1) % 3;
+                const Index l = (i + 2) % 3;
+                const T *a1 = &(m1.m_data[j*N]), *a2 = &(m1.m_data[l*N]);
+                const T *b1 = &(m2.m_data[j*N]), *b2 = &(m2.m_data[l*N]);
+                T *dst = &(ret.m_data[i*N]);
+                for(Index k=0;k<N;k++){
+                    dst[k] = a1[k] * b2[k] - a2[k] * b1[k];
+                }
+            }
+            return ret;
+        }
+
+        // =============== Features for vector usage ends ================
+
+        /**
+         * @brief Apply \p func to every element of \p x .
+         * @return Batch of results.
+         */
+        template<typename F>
+        INLINE static MatrixBatch apply(const MatrixBatch &x, F func){
+            MatrixBatch ret;
+            for(Index i=0;i<Size;i++){
+                ret.m_data[i] = func(x.m_data[i]);
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Apply \p func to every pair of elements of \p x and \p y .
+         * @return Batch of results.
+         */
+        template<typename F>
+        INLINE static MatrixBatch apply(const MatrixBatch &x, const MatrixBatch &y, F func){
+            MatrixBatch ret;
+            for(Index i=0;i<Size;i++){
+                ret.m_data[i] = func(x.m_data[i], y.m_data[i]);
+            }
+            return ret;
+        }
+
+        // Lane-interleaved elements. Element (r, c) of k'th matrix is located
+        // at `m_data[index(r, c) + k]`.
+        Impl::storage_t<T, Size, Storage::Auto> m_data;
+    };
+
+    /**
+     * @brief Element-wise sum of batches.
+     */
+    template<typename T, Index R, Index C, Index N>
+    MatrixBatch<T, R, C, N> operator+(const MatrixBatch<T, R, C, N> &x, const MatrixBatch<T, R, C, N> &y){
+        return MatrixBatch<T, R, C, N>::apply(x, y, [](T a, T b){ return a + b; });
+    }
+
+    /**
+     * @brief Element-wise subtraction of batches.
+     */
+    template<typename T, Index R, Index C, Index N>
+    MatrixBatch<T, R, C, N> operator-(const MatrixBatch<T, R, C, N> &x, const MatrixBatch<T, R, C, N> &y){
+        return MatrixBatch<T, R, C, N>::apply(x, y, [](T a, T b){ return a - b; });
+    }
+
+    /**
+     * @brief Element-wise product of batches. See `operator%()` of matrices.
+     */
+    template<typename T, Index R, Index C, Index N>
+    MatrixBatch<T, R, C, N> operator%(const MatrixBatch<T, R, C, N> &x, const MatrixBatch<T, R, C, N> &y){
+        return MatrixBatch<T, R, C, N>::apply(x, y, [](T a, T b){ return a * b; });
+    }
+
+    /**
+     * @brief Element-wise division of batches. See `EDiv()` of matrices.
+     */
+    template<typename T, Index R, Index C, Index N>
+    MatrixBatch<T, R, C, N> EDiv(const MatrixBatch<T, R, C, N> &x, const MatrixBatch<T, R, C, N> &y){
+        return MatrixBatch<T, R, C, N>::apply(x, y, [](T a, T b){ return a / b; });
+    }
+
+    /**
+     * @brief Negation of every matrix in a batch.
+     */
+    template<typename T, Index R, Index C, Index N>
+    MatrixBatch<T, R, C, N> operator-(const MatrixBatch<T, R, C, N> &x){
+        return MatrixBatch<T, R, C, N>::apply(x, [](T a){ return -a; });
+    }
+
+    /**
+     * @brief Multiply a scalar to every matrix in a batch.
+     */
+    template<typename T, Index R, Index C, Index N>
+    MatrixBatch<T, R, C, N> operator*(const MatrixBatch<T, R, C, N> &x, const T &y){
+        return MatrixBatch<T, R, C, N>::apply(x, [y](T a){ return a * y; });
+    }
+
+    /**
+     * @brief Divide every matrix in a batch by a scalar.
+     */
+    template<typename T, Index R, Index C, Index N>
+    MatrixBatch<T, R, C, N> operator/(const MatrixBatch<T, R, C, N> &x, const T &y){
+        return MatrixBatch<T, R, C, N>::apply(x, [y](T a){ return a / y; });
+    }
+
+    /**
+     * @brief Multiplication of every pair of matrices in batches.
+     * @return Batch of products.
+     */
+    template<typename T, Index R, Index K, Index C, Index N>
+    MatrixBatch<T, R, C, N> operator*(const MatrixBatch<T, R, K, N> &x, const MatrixBatch<T, K, C, N> &y){
+        MatrixBatch<T, R, C, N> ret;
+        for(Index r=0;r<R;r++){
+            for(Index c=0;c<C;c++){
+                T *dst = ret.lanes(r, c);
+                const T *a = x.lanes(r, 0);
+                const T *b = y.lanes(0, c);
+                for(Index k=0;k<N;k++){
+                    dst[k] = a[k] * b[k];
+                }
+                for(Index i=1;i<K;i++){
+                    a = x.lanes(r, i);
+                    b = y.lanes(i, c);
+                    for(Index k=0;k<N;k++){
+                        dst[k] += a[k] * b[k];
+                    }
+                }
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Transpose every matrix in a batch.
+     */
+    template<typename Type, Index R, Index C, Index N>
+    MatrixBatch<Type, C, R, N> T(const MatrixBatch<Type, R, C, N> &x){
+        MatrixBatch<Type, C, R, N> ret;
+        for(Index r=0;r<R;r++){
+            for(Index c=0;c<C;c++){
+                memcpy(ret.lanes(c, r), x.lanes(r, c), sizeof(Type)*N);
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Inverse of every matrix in a batch, using the adjugate matrix
+     *        as `Inverse()` does. Elements of the result are `Float` type.
+     */
+    template<typename T, Index R, Index C, Index N> requires (R == C)
+    MatrixBatch<Float, R, C, N> Inverse(const MatrixBatch<T, R, C, N> &x){
+        MatrixBatch<Float, R, C, N> xf;
+        for(Index i=0;i<R*C*N;i++){
+            xf.m_data[i] = static_cast<Float>(x.m_data[i]);
+        }
+        MatrixBatch<Float, R, C, N> ret;
+        if constexpr (R == 1){
+            const Float *a = xf.lanes(0, 0);
+            Float *dst = ret.lanes(0, 0);
+            for(Index k=0;k<N;k++){
+                dst[k] = static_cast<Float>(1) / a[k];
+            }
+        }
+        else{
+            // Transposed cofactors
+            for_<R>([&] (auto r) {
+                for_<C>([&] (auto c) {
+                    const auto sub = xf.template minor<r.value, c.value>().det();
+                    Float *dst = ret.lanes(c.value, r.value);
+                    for(Index k=0;k<N;k++){
+                        dst[k] = ((r.value + c.value) % 2) ? -sub[k] : sub[k];
+                    }
+                });
+            });
+            // Expansion along the first row
+            std::array<Float, N> invdet;
+            invdet.fill(static_cast<Float>(0));
+            for(Index c=0;c<C;c++){
+                const Float *a = xf.lanes(0, c);
+                const Float *cof = ret.lanes(c, 0);
+                for(Index k=0;k<N;k++){
+                    invdet[k] += a[k] * cof[k];
+                }
+            }
+            for(Index k=0;k<N;k++){
+                invdet[k] = static_cast<Float>(1) / invdet[k];
+            }
+            for(Index i=0;i<R*C;i++){
+                Float *dst = &(ret.m_data[i*N]);
+                for(Index k=0;k<N;k++){
+                    dst[k] *= invdet[k];
+                }
+            }
+        }
+        return ret;
+    }
+}
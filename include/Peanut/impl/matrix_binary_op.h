@@ -27,10 +27,12 @@
 // Standard headers
 
 // Peanut headers
+#include <Peanut/impl/binary_expr/matrix_chain.h>
 #include <Peanut/impl/binary_expr/matrix_div_scalar.h>
 #include <Peanut/impl/binary_expr/matrix_ediv.h>
 #include <Peanut/impl/binary_expr/matrix_mult.h>
 #include <Peanut/impl/binary_expr/matrix_mult_scalar.h>
+#include <Peanut/impl/binary_expr/matrix_packed_mult.h>
 #include <Peanut/impl/binary_expr/matrix_subtract.h>
 #include <Peanut/impl/binary_expr/matrix_sum.h>
 #include <Peanut/impl/binary_expr/matrix_emult.h>
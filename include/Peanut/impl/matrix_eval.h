@@ -0,0 +1,265 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Evaluate an arbitrary matrix expression element by element
+     *        into a matrix, in the storage order of the matrix. It is the
+     *        default implementation of `eval()` of matrix expressions.
+     * @details If the size of \p _result is `Dynamic`, it is resized to the
+     *          size of \p expr first. If both \p _result and \p expr are
+     *          linearly accessible in the same order (See `is_linear_pair`),
+     *          elements are evaluated in a single flat loop using `coeff()`.
+     *          If \p expr is also vectorizable (See `is_vectorizable`), the
+     *          loop evaluates SIMD packets using `packet()` and the remaining
+     *          tail using `coeff()`. If \p expr is element-wise operations on
+     *          a product (See `has_epilogue`), they are applied to each row of
+     *          the product right after it is computed, instead of reading
+     *          the product element by element. Small fixed-size expressions
+     *          (See `is_unrolled`) are evaluated by fully unrolled code, and
+     *          others by runtime loops (See `for_each_index_sized()`).
+     * @param _result Evaluated matrix (reference output).
+     * @param expr Arbitrary Peanut matrix expression.
+     * @tparam M Matrix type which has lvalue `operator()`.
+     * @tparam E Matrix expression type.
+     */
+    template <typename M, typename E>
+    INLINE void evaluate(M &_result, const E &expr) {
+        if constexpr (M::Row == Dynamic || M::Col == Dynamic) {
+            _result.resize(expr.rows(), expr.cols());
+        }
+        if constexpr (is_linear_pair_v<M, E>) {
+            auto *dst = _result.m_data.data();
+            constexpr bool Vectorized = is_vectorizable_v<E> && has_packet_v<typename M::Type> &&
+                                        std::is_same_v<typename M::Type, typename E::Type>;
+            constexpr Index P = Vectorized ? Packet<typename M::Type>::Size : 1;
+            // Packets start at multiples of `P`, so that aligned leaves are
+            // read by aligned loads
+            auto store = [&](const auto &packet, Index i) {
+                if constexpr (is_packet_aligned_v<M>) {
+                    packet.store_aligned(dst + i);
+                }
+                else {
+                    packet.store(dst + i);
+                }
+            };
+            if constexpr (is_unrolled_v<E::Row, E::Col>) {
+                constexpr Index size = E::Row * E::Col;
+                constexpr Index tail = Vectorized ? size / P * P : 0;
+                if constexpr (Vectorized && size / P > 0) {
+                    for_<size / P>([&](auto i) {
+                        store(expr.template packet<true>(i.value * P), i.value * P);
+                    });
+                }
+                if constexpr (size - tail > 0) {
+                    for_<size - tail>([&](auto i) {
+                        constexpr Index j = tail + i.value;
+                        dst[j] = expr.coeff(j);
+                    });
+                }
+            }
+            else {
+                const Index size = expr.rows() * expr.cols();
+                Index i = 0;
+                if constexpr (Vectorized) {
+                    for (; i + P <= size; i += P) {
+                        store(expr.template packet<true>(i), i);
+                    }
+                }
+                for (; i < size; i++) {
+                    dst[i] = expr.coeff(i);
+                }
+            }
+        }
+        else if constexpr (is_unrolled_v<E::Row, E::Col>) {
+            // Small expressions, including products, are evaluated element
+            // by element in unrolled code
+            for_each_index_sized<M::StorageOrder, E::Row, E::Col>(expr.rows(), expr.cols(), [&](Index r, Index c) {
+                _result(r, c) = expr(r, c);
+            });
+        }
+        else if constexpr (has_epilogue_v<E>) {
+            // Each row of the product is accumulated into a scratch row, and
+            // element-wise operations on it are applied while it is hot
+            const auto &prod = expr.product();
+            using P = std::remove_cvref_t<decltype(prod)>;
+            std::conditional_t<P::Col == Dynamic, std::vector<typename P::Type>,
+                               std::array<typename P::Type, P::Col>> row{};
+            if constexpr (P::Col == Dynamic) {
+                row.resize(prod.cols());
+            }
+            const Index rows = expr.rows();
+            const Index cols = expr.cols();
+            for (Index r = 0; r < rows; r++) {
+                prod.eval_row(r, row);
+                for (Index c = 0; c < cols; c++) {
+                    _result(r, c) = expr.epilogue(r, c, row[c]);
+                }
+            }
+        }
+        else {
+            for_each_index_sized<M::StorageOrder, E::Row, E::Col>(expr.rows(), expr.cols(), [&](Index r, Index c) {
+                _result(r, c) = expr(r, c);
+            });
+        }
+    }
+
+    /**
+     * @brief Evaluate element-wise compound assignment (e.g., `m += expr`)
+     *        in place, as `op(m, expr)` evaluated directly into \p m .
+     * @details `op(m, expr)` reads each element of \p m only at the position
+     *          it writes, so only \p expr is checked for aliasing against
+     *          [\p begin, \p end), the memory of \p m . It is evaluated into
+     *          a temporary matrix only if they overlap.
+     * @param m Matrix to be assigned.
+     * @param expr Right hand side Peanut matrix expression.
+     * @param begin Pointer to the first element of \p m .
+     * @param end Pointer past the last element of \p m .
+     * @param op Function which builds element-wise expression of \p m and \p expr .
+     */
+    template <typename M, typename E, typename Op>
+    INLINE void compound_assign(M &m, const E &expr, const typename M::Type *begin,
+                                const typename M::Type *end, Op op) {
+        check_equal_size(m, expr);
+        if constexpr (!is_linear_pair_v<M, E>) {
+            if (expr.aliases(begin, end)) {
+                const eval_t<E> tmp(expr);
+                op(std::as_const(m), tmp).eval(m);
+                return;
+            }
+        }
+        op(std::as_const(m), expr).eval(m);
+    }
+
+    /**
+     * @brief Multiply \p m by square matrix \p b in place, row by row.
+     * @details Each row of the product only depends on the same row of \p m ,
+     *          so it is accumulated into a single scratch row and then copied
+     *          back, instead of evaluating the whole product into a temporary.
+     * @param m Matrix to be assigned.
+     * @param b Square matrix which does not overlap \p m .
+     */
+    template <typename M, typename E>
+    INLINE void multiply_rows(M &m, const E &b) {
+        using T = typename M::Type;
+        const Index rows = m.rows();
+        const Index cols = m.cols();
+        std::conditional_t<M::Col == Dynamic, std::vector<T>, std::array<T, M::Col>> row{};
+        if constexpr (M::Col == Dynamic) {
+            row.resize(cols);
+        }
+        for (Index i = 0; i < rows; i++) {
+            const T first = m(i, 0);
+            for (Index j = 0; j < cols; j++) {
+                row[j] = first * b(0, j);
+            }
+            for (Index k = 1; k < cols; k++) {
+                const T a = m(i, k);
+                for (Index j = 0; j < cols; j++) {
+                    row[j] += a * b(k, j);
+                }
+            }
+            for (Index j = 0; j < cols; j++) {
+                m(i, j) = row[j];
+            }
+        }
+    }
+
+    /**
+     * @brief Evaluate `m *= expr` in place, where \p expr is square.
+     * @details \p expr is read once per row of \p m , so it is evaluated
+     *          into a temporary matrix unless it is a leaf (See `is_leaf`)
+     *          which does not overlap [\p begin, \p end), the memory of \p m .
+     *          See `multiply_rows()`.
+     * @param m Matrix to be assigned.
+     * @param expr Right hand side square Peanut matrix expression.
+     * @param begin Pointer to the first element of \p m .
+     * @param end Pointer past the last element of \p m .
+     */
+    template <typename M, typename E>
+    INLINE void multiply_assign(M &m, const E &expr, const typename M::Type *begin,
+                                const typename M::Type *end) {
+        check_mult_size(m, expr);
+        if constexpr (E::Row == Dynamic || E::Col == Dynamic) {
+            if (expr.rows() != expr.cols()) {
+                throw std::invalid_argument("Matrix size mismatch");
+            }
+        }
+        if constexpr (is_leaf_v<E>) {
+            if (!expr.aliases(begin, end)) {
+                multiply_rows(m, expr);
+                return;
+            }
+        }
+        const eval_t<E> tmp(expr);
+        multiply_rows(m, tmp);
+    }
+
+    /**
+     * @brief Proxy of a matrix returned by `noalias()`, whose assignment
+     *        evaluates an expression directly into the matrix without
+     *        checking aliasing.
+     * @tparam M Matrix type.
+     */
+    template <typename M>
+    struct NoAlias {
+        M &m;
+
+        /**
+         * @brief Evaluate \p expr directly into the matrix. \p expr must not
+         *        read elements of the matrix, except at the same position in
+         *        element-wise operations.
+         * @param expr Arbitrary Peanut matrix expression.
+         * @return Reference of the matrix.
+         */
+        template <typename E> requires is_equal_type_size_v<E, M>
+        M &operator=(const MatrixExpr<E> &expr) {
+            const E &e = static_cast<const E &>(expr);
+            // Dynamic matrix is resized in evaluation
+            if constexpr (M::Row != Dynamic) {
+                check_equal_size(m, e);
+            }
+            e.eval(m);
+            return m;
+        }
+    };
+}
@@ -0,0 +1,175 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Deferred assignment of a matrix expression into a matrix, which
+     *        is evaluated together with others by `EvalAll()`.
+     * @tparam M Matrix type which has lvalue `operator()`.
+     * @tparam E Matrix expression type.
+     */
+    template <typename M, typename E>
+    struct Assignment {
+        M &m;
+        nested_t<E> expr;
+    };
+
+    /**
+     * @brief Call `f(values_i, outputs_i)` for each i'th element of tuples.
+     */
+    template <typename V, typename O, typename F>
+    INLINE void zip_apply(const V &values, const O &outputs, F f) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (f(std::get<I>(values), std::get<I>(outputs)), ...);
+        }(std::make_index_sequence<std::tuple_size_v<V>>{});
+    }
+}
+
+namespace Peanut {
+
+    /**
+     * @brief Assignment of \p expr into \p m , which is evaluated by
+     *        `EvalAll()`. See `Impl::Assignment`.
+     * @tparam M Matrix type.
+     * @tparam E Matrix expression type.
+     * @param m Matrix to be assigned.
+     * @param expr Matrix expression.
+     * @return Constructed `Impl::Assignment` instance
+     */
+    template <typename M, typename E>
+        requires is_matrix_v<M> && is_equal_type_size_v<E, M>
+    Impl::Assignment<M, E> Assign(M &m, const MatrixExpr<E> &expr) {
+        return {m, static_cast<const E &>(expr)};
+    }
+
+    /**
+     * @brief Evaluate several same-sized matrix expressions into matrices
+     *        in a single loop, so that operands shared by them are read
+     *        from memory once, instead of once per assignment.
+     *
+     *     EvalAll(Assign(sum, a + b), Assign(diff, a - b), Assign(prod, a % b));
+     *
+     * @details Values of all expressions at a position are computed before
+     *          any of them is written, so element-wise expressions may read
+     *          the matrices being assigned (e.g., swapping `a` and `b`). If
+     *          any other expression reads them, every expression is
+     *          evaluated into a temporary first. If all assignments are
+     *          linearly accessible in the same order (See `is_linear_pair`),
+     *          they are evaluated in a flat loop, by SIMD packets if all of
+     *          them are vectorizable with the same type.
+     * @param as Assignments built by `Assign()`.
+     */
+    template <typename... M, typename... E>
+        requires (sizeof...(E) > 0) &&
+                 (is_equal_size_mat_v<E, std::tuple_element_t<0, std::tuple<E...>>> && ...)
+    void EvalAll(const Impl::Assignment<M, E> &... as) {
+        const auto outputs = std::forward_as_tuple(as...);
+        const auto &first = std::get<0>(outputs).expr;
+        const Index rows = first.rows();
+        const Index cols = first.cols();
+        ([&](const auto &a) {
+            using N = std::remove_cvref_t<decltype(a.m)>;
+            if constexpr (N::Row == Dynamic || N::Col == Dynamic) {
+                a.m.resize(rows, cols);
+            }
+            Impl::check_equal_size(a.m, first);
+            Impl::check_equal_size(a.expr, first);
+        }(as), ...);
+        if (rows == 0 || cols == 0) {
+            return;
+        }
+
+        // Element-wise expressions only read the position they write
+        auto conflicts = [&](const auto &a) {
+            if constexpr (is_linear_v<std::remove_cvref_t<decltype(a.expr)>>) {
+                return false;
+            }
+            else {
+                return (a.expr.aliases(&as.m(0, 0), &as.m(rows - 1, cols - 1) + 1) || ...);
+            }
+        };
+        if ((conflicts(as) || ...)) {
+            const std::tuple<const eval_t<E>...> tmps{eval_t<E>(as.expr)...};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                EvalAll(Assign(as.m, std::get<I>(tmps))...);
+            }(std::index_sequence_for<E...>{});
+            return;
+        }
+
+        using M0 = std::tuple_element_t<0, std::tuple<M...>>;
+        using T0 = typename M0::Type;
+        constexpr bool Flat = (is_linear_pair_v<M, E> && ...) &&
+                              ((storage_order_v<M> == storage_order_v<M0>) && ...);
+        if constexpr (Flat) {
+            const Index size = rows * cols;
+            Index i = 0;
+            if constexpr ((is_vectorizable_v<E> && ...) && Impl::has_packet_v<T0> &&
+                          ((std::is_same_v<typename M::Type, T0> && std::is_same_v<typename E::Type, T0>) && ...)) {
+                constexpr Index P = Impl::Packet<T0>::Size;
+                for (; i + P <= size; i += P) {
+                    const std::tuple packets{as.expr.template packet<true>(i)...};
+                    Impl::zip_apply(packets, outputs, [&](const auto &p, const auto &a) {
+                        if constexpr (is_packet_aligned_v<std::remove_cvref_t<decltype(a.m)>>) {
+                            p.store_aligned(a.m.m_data.data() + i);
+                        }
+                        else {
+                            p.store(a.m.m_data.data() + i);
+                        }
+                    });
+                }
+            }
+            for (; i < size; i++) {
+                const std::tuple values{as.expr.coeff(i)...};
+                Impl::zip_apply(values, outputs, [&](const auto &v, const auto &a) {
+                    a.m.m_data.data()[i] = v;
+                });
+            }
+        }
+        else {
+            for_each_index_sized<storage_order_v<M0>, M0::Row, M0::Col>(rows, cols, [&](Index r, Index c) {
+                const std::tuple values{as.expr(r, c)...};
+                Impl::zip_apply(values, outputs, [&](const auto &v, const auto &a) {
+                    a.m(r, c) = v;
+                });
+            });
+        }
+    }
+}
@@ -0,0 +1,397 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Reduce `map(load(i))` for `i` in [0, \p size) by `fold`, using four
+     *        independent accumulators so that consecutive folds do not wait
+     *        for each other. \p size must be positive.
+     * @param size Number of elements.
+     * @param load Function which returns i'th element (scalar or packet).
+     * @param map Function applied to each element (e.g., square).
+     * @param fold Associative binary function (e.g., addition).
+     * @return Reduced value
+     */
+    template <typename Load, typename Map, typename Fold>
+    INLINE auto reduce_range(Index size, Load load, Map map, Fold fold) {
+        auto acc0 = map(load(0));
+        if (size < 4) {
+            for (Index i = 1; i < size; i++) {
+                acc0 = fold(acc0, map(load(i)));
+            }
+            return acc0;
+        }
+        auto acc1 = map(load(1));
+        auto acc2 = map(load(2));
+        auto acc3 = map(load(3));
+        Index i = 4;
+        for (; i + 4 <= size; i += 4) {
+            acc0 = fold(acc0, map(load(i)));
+            acc1 = fold(acc1, map(load(i + 1)));
+            acc2 = fold(acc2, map(load(i + 2)));
+            acc3 = fold(acc3, map(load(i + 3)));
+        }
+        for (; i < size; i++) {
+            acc0 = fold(acc0, map(load(i)));
+        }
+        return fold(fold(acc0, acc1), fold(acc2, acc3));
+    }
+
+    /**
+     * @brief Check if a matrix expression has no element, which is possible
+     *        only if its size is `Dynamic`.
+     * @param expr Arbitrary Peanut matrix expression.
+     * @return True if \p expr has no element
+     */
+    template <typename E>
+    INLINE bool is_empty(const E &expr) {
+        if constexpr (E::Row == Dynamic || E::Col == Dynamic) {
+            return expr.rows() == 0 || expr.cols() == 0;
+        }
+        else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Reduce every element of an arbitrary matrix expression, as
+     *        `fold(... fold(map(e0), map(e1)) ..., map(en))`, streaming the
+     *        expression once without evaluating it into a temporary.
+     * @details Linearly accessible expressions (See `is_linear`) are reduced
+     *          in a single flat loop, by SIMD packets if vectorizable (See
+     *          `is_vectorizable`), so \p map and \p fold are also called with
+     *          `Packet<Type>`. Element-wise operations on a product (See
+     *          `has_epilogue`) are reduced row by row of the product. Other
+     *          expressions are reduced line by line in their storage order.
+     * @param expr Arbitrary Peanut matrix expression, which has at least one element.
+     * @param map Function applied to each element.
+     * @param fold Associative and commutative binary function.
+     * @return Reduced value
+     */
+    template <typename E, typename Map, typename Fold>
+    INLINE auto reduce(const E &expr, Map map, Fold fold) {
+        using Type = typename E::Type;
+        const Index rows = expr.rows();
+        const Index cols = expr.cols();
+
+        if constexpr (is_linear_v<E>) {
+            const Index size = rows * cols;
+            if constexpr (is_vectorizable_v<E> && has_packet_v<Type>) {
+                constexpr Index P = Packet<Type>::Size;
+                if (size >= P) {
+                    const auto acc = reduce_range(size / P, [&](Index i) { return expr.template packet<true>(i * P); }, map, fold);
+                    std::array<Type, P> lanes;
+                    acc.store(lanes.data());
+                    auto ret = lanes[0];
+                    for (Index j = 1; j < P; j++) {
+                        ret = fold(ret, lanes[j]);
+                    }
+                    for (Index i = size / P * P; i < size; i++) {
+                        ret = fold(ret, map(static_cast<Type>(expr.coeff(i))));
+                    }
+                    return ret;
+                }
+            }
+            return reduce_range(size, [&](Index i) { return static_cast<Type>(expr.coeff(i)); }, map, fold);
+        }
+        else if constexpr (has_epilogue_v<E>) {
+            const auto &prod = expr.product();
+            using P = std::remove_cvref_t<decltype(prod)>;
+            std::conditional_t<P::Col == Dynamic, std::vector<typename P::Type>,
+                               std::array<typename P::Type, P::Col>> row{};
+            if constexpr (P::Col == Dynamic) {
+                row.resize(prod.cols());
+            }
+            auto reduce_row = [&](Index r) {
+                prod.eval_row(r, row);
+                return reduce_range(cols, [&](Index c) { return static_cast<Type>(expr.epilogue(r, c, row[c])); },
+                                    map, fold);
+            };
+            auto ret = reduce_row(0);
+            for (Index r = 1; r < rows; r++) {
+                ret = fold(ret, reduce_row(r));
+            }
+            return ret;
+        }
+        else {
+            constexpr bool RowMajor = storage_order_v<E> == Layout::RowMajor;
+            const Index lines = RowMajor ? rows : cols;
+            auto reduce_line = [&](Index l) {
+                return reduce_range(RowMajor ? cols : rows, [&](Index i) {
+                    return static_cast<Type>(RowMajor ? expr(l, i) : expr(i, l));
+                }, map, fold);
+            };
+            auto ret = reduce_line(0);
+            for (Index l = 1; l < lines; l++) {
+                ret = fold(ret, reduce_line(l));
+            }
+            return ret;
+        }
+    }
+
+    // Element functions of reductions, which accept both scalars and packets
+    inline constexpr auto identity = [](auto a) { return a; };
+    inline constexpr auto square = [](auto a) { return a * a; };
+    inline constexpr auto absolute = [](auto a) {
+        if constexpr (std::is_unsigned_v<decltype(a)>) {
+            return a;
+        }
+        else {
+            using std::abs;
+            return abs(a);
+        }
+    };
+    inline constexpr auto plus = [](auto a, auto b) { return a + b; };
+    inline constexpr auto times = [](auto a, auto b) { return a * b; };
+    inline constexpr auto minimum = [](auto a, auto b) { using std::min; return min(a, b); };
+    inline constexpr auto maximum = [](auto a, auto b) { using std::max; return max(a, b); };
+
+    /**
+     * @brief Reduction policies used by partial reductions (See
+     *        `MatrixPartialReduction`). Each one provides `map` and `fold` as
+     *        `reduce()` takes, `finalize(acc, n)` which gives the result from
+     *        the reduced value `acc` of `n` elements, and `Floating` which is
+     *        true if the result is `Float` type.
+     */
+    struct SumReduction {
+        static constexpr auto map = identity;
+        static constexpr auto fold = plus;
+        static constexpr bool Floating = false;
+        template <typename T>
+        INLINE static T finalize(T acc, Index) { return acc; }
+    };
+
+    struct MeanReduction {
+        static constexpr auto map = identity;
+        static constexpr auto fold = plus;
+        static constexpr bool Floating = true;
+        template <typename T>
+        INLINE static Float finalize(T acc, Index n) { return static_cast<Float>(acc) / static_cast<Float>(n); }
+    };
+
+    struct MinReduction {
+        static constexpr auto map = identity;
+        static constexpr auto fold = minimum;
+        static constexpr bool Floating = false;
+        template <typename T>
+        INLINE static T finalize(T acc, Index) { return acc; }
+    };
+
+    struct MaxReduction {
+        static constexpr auto map = identity;
+        static constexpr auto fold = maximum;
+        static constexpr bool Floating = false;
+        template <typename T>
+        INLINE static T finalize(T acc, Index) { return acc; }
+    };
+
+    struct SquaredNormReduction {
+        static constexpr auto map = square;
+        static constexpr auto fold = plus;
+        static constexpr bool Floating = false;
+        template <typename T>
+        INLINE static T finalize(T acc, Index) { return acc; }
+    };
+
+    struct NormReduction {
+        static constexpr auto map = square;
+        static constexpr auto fold = plus;
+        static constexpr bool Floating = true;
+        template <typename T>
+        INLINE static Float finalize(T acc, Index) { return std::sqrt(static_cast<Float>(acc)); }
+    };
+}
+
+namespace Peanut {
+
+    /**
+     * @brief Sum of all elements of a matrix expression, which is computed
+     *        without evaluating the expression into a temporary
+     *        (e.g., `Sum(EMult(A - B, A - B))`). See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Sum of elements, 0 if the expression is empty
+     */
+    template <typename E> requires is_matrix_v<E>
+    typename E::Type Sum(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        if (Impl::is_empty(e)) {
+            return static_cast<typename E::Type>(0);
+        }
+        return Impl::reduce(e, Impl::identity, Impl::plus);
+    }
+
+    /**
+     * @brief Product of all elements of a matrix expression. See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Product of elements, 1 if the expression is empty
+     */
+    template <typename E> requires is_matrix_v<E>
+    typename E::Type Prod(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        if (Impl::is_empty(e)) {
+            return static_cast<typename E::Type>(1);
+        }
+        return Impl::reduce(e, Impl::identity, Impl::times);
+    }
+
+    /**
+     * @brief Mean of all elements of a matrix expression. See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Float type mean of elements, NaN if the expression is empty
+     */
+    template <typename E> requires is_matrix_v<E>
+    Float Mean(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        return static_cast<Float>(Sum(e)) / static_cast<Float>(e.rows() * e.cols());
+    }
+
+    /**
+     * @brief Minimum element of a matrix expression. It throws
+     *        `std::invalid_argument` if the expression is empty. See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Minimum element
+     */
+    template <typename E> requires is_matrix_v<E>
+    typename E::Type MinCoeff(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        if (Impl::is_empty(e)) {
+            throw std::invalid_argument("Reduction of empty matrix");
+        }
+        return Impl::reduce(e, Impl::identity, Impl::minimum);
+    }
+
+    /**
+     * @brief Maximum element of a matrix expression. It throws
+     *        `std::invalid_argument` if the expression is empty. See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Maximum element
+     */
+    template <typename E> requires is_matrix_v<E>
+    typename E::Type MaxCoeff(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        if (Impl::is_empty(e)) {
+            throw std::invalid_argument("Reduction of empty matrix");
+        }
+        return Impl::reduce(e, Impl::identity, Impl::maximum);
+    }
+
+    /**
+     * @brief Sum of squares of all elements of a matrix expression, i.e.,
+     *        the square of its Frobenius norm. See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Sum of squared elements, 0 if the expression is empty
+     */
+    template <typename E> requires is_matrix_v<E>
+    typename E::Type SquaredNorm(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        if (Impl::is_empty(e)) {
+            return static_cast<typename E::Type>(0);
+        }
+        return Impl::reduce(e, Impl::square, Impl::plus);
+    }
+
+    /**
+     * @brief Frobenius norm of a matrix expression, i.e., square root of
+     *        the sum of squares of all elements. See `SquaredNorm`.
+     * @tparam E Matrix expression type.
+     * @return Float type Frobenius norm
+     */
+    template <typename E> requires is_matrix_v<E>
+    Float Norm(const MatrixExpr<E> &x) {
+        return std::sqrt(static_cast<Float>(SquaredNorm(x)));
+    }
+
+    /**
+     * @brief Element-wise L1 norm of a matrix expression, i.e., the sum of
+     *        absolute values of all elements. See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Sum of absolute values of elements, 0 if the expression is empty
+     */
+    template <typename E> requires is_matrix_v<E>
+    typename E::Type NormL1(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        if (Impl::is_empty(e)) {
+            return static_cast<typename E::Type>(0);
+        }
+        return Impl::reduce(e, Impl::absolute, Impl::plus);
+    }
+
+    /**
+     * @brief Element-wise infinity norm of a matrix expression, i.e., the
+     *        maximum absolute value of all elements. See `Impl::reduce`.
+     * @tparam E Matrix expression type.
+     * @return Maximum absolute value of elements, 0 if the expression is empty
+     */
+    template <typename E> requires is_matrix_v<E>
+    typename E::Type NormLinf(const MatrixExpr<E> &x) {
+        const E &e = static_cast<const E &>(x);
+        if (Impl::is_empty(e)) {
+            return static_cast<typename E::Type>(0);
+        }
+        return Impl::reduce(e, Impl::absolute, Impl::maximum);
+    }
+
+    /**
+     * @brief Trace of a square matrix expression, i.e., the sum of its
+     *        diagonal elements. Only the diagonal elements are computed
+     *        (e.g., `Trace(A * B)` computes `n` dot products).
+     * @tparam E Matrix expression type.
+     * @return Sum of diagonal elements
+     */
+    template <typename E> requires is_matrix_v<E> && (E::Row == E::Col || E::Row == Dynamic || E::Col == Dynamic)
+    typename E::Type Trace(const MatrixExpr<E> &x) {
+        using Type = typename E::Type;
+        const E &e = static_cast<const E &>(x);
+        if constexpr (E::Row == Dynamic || E::Col == Dynamic) {
+            if (e.rows() != e.cols()) {
+                throw std::invalid_argument("Matrix size mismatch");
+            }
+            if (e.rows() == 0) {
+                return static_cast<Type>(0);
+            }
+        }
+        return Impl::reduce_range(e.rows(), [&](Index i) { return static_cast<Type>(e(i, i)); },
+                                  Impl::identity, Impl::plus);
+    }
+}
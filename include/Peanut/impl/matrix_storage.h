@@ -0,0 +1,381 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+
+// Dependencies headers
+
+/**
+ * @brief Maximum size in bytes of a matrix which is stored inline when
+ *        `Storage::Auto` is used. Larger matrices are stored on the heap.
+ *        It can be overridden by defining it before including Peanut.
+ */
+#ifndef PEANUT_INLINE_STORAGE_LIMIT
+#define PEANUT_INLINE_STORAGE_LIMIT 16384
+#endif
+
+/**
+ * @brief Row pitch in bytes which is regarded as causing cache-set aliasing
+ *        when it is a multiple of it. See `aliasing_free_ld`.
+ */
+#ifndef PEANUT_ALIASING_STRIDE
+#define PEANUT_ALIASING_STRIDE 512
+#endif
+
+/**
+ * @brief Width in bytes of the widest SIMD register of the target, used for
+ *        row padding. It can be overridden by defining it before including Peanut.
+ */
+#ifndef PEANUT_VECTOR_BYTES
+#if defined(__AVX512F__)
+#define PEANUT_VECTOR_BYTES 64
+#elif defined(__AVX__)
+#define PEANUT_VECTOR_BYTES 32
+#else
+#define PEANUT_VECTOR_BYTES 16
+#endif
+#endif
+
+namespace Peanut {
+
+    /**
+     * @brief Storage policy of `Matrix`.
+     * @details `Inline` stores elements in the matrix object itself
+     *          (i.e., on the stack for local variables), `Heap` stores them in
+     *          an aligned heap buffer owned by the matrix, and `Auto` chooses
+     *          `Heap` if the matrix is larger than `PEANUT_INLINE_STORAGE_LIMIT`
+     *          bytes, `Inline` otherwise. `Shared` stores them in a
+     *          reference-counted heap buffer which is shared by copies of the
+     *          matrix, and copied only when one of them is modified
+     *          (copy-on-write). It is never chosen by `Auto`.
+     */
+    enum class Storage {
+        Auto,
+        Inline,
+        Heap,
+        Shared
+    };
+
+    /**
+     * @brief Compile-time structure which resolves `Storage::Auto` to a
+     *        concrete storage policy.
+     * @tparam T Data type.
+     * @tparam N Number of elements.
+     * @tparam S Requested storage policy.
+     */
+    template <typename T, std::size_t N, Storage S>
+    struct resolve_storage{
+        static constexpr Storage value = (S != Storage::Auto) ? S :
+                                         (sizeof(T) * N > PEANUT_INLINE_STORAGE_LIMIT) ? Storage::Heap : Storage::Inline;
+    };
+
+    /**
+     * @brief Helper variable template for `resolve_storage<T, N, S>`.
+     */
+    template <typename T, std::size_t N, Storage S>
+    constexpr Storage resolve_storage_v = resolve_storage<T, N, S>::value;
+
+    /**
+     * @brief Compile-time structure which computes a leading dimension
+     *        which starts every row on a `PEANUT_VECTOR_BYTES` boundary.
+     * @details `value` is \p C rounded up to a multiple of the number of
+     *          \p T elements in a SIMD register.
+     * @tparam T Data type.
+     * @tparam C Column size.
+     */
+    template <typename T, Index C>
+    struct padded_ld{
+        static constexpr Index lanes = (sizeof(T) < PEANUT_VECTOR_BYTES) ? PEANUT_VECTOR_BYTES / sizeof(T) : 1;
+        static constexpr Index value = (C + lanes - 1) / lanes * lanes;
+    };
+
+    /**
+     * @brief Helper variable template for `padded_ld<T, C>`.
+     */
+    template <typename T, Index C>
+    constexpr Index padded_ld_v = padded_ld<T, C>::value;
+
+    /**
+     * @brief Compile-time structure which computes a leading dimension
+     *        which avoids cache-set aliasing when walking a column.
+     * @details If a row pitch of \p C elements is a multiple of
+     *          `PEANUT_ALIASING_STRIDE` bytes (e.g., 256, 512 or 1024 float
+     *          columns), consecutive rows are mapped to only a few cache sets
+     *          and evict each other. In that case `value` is \p C plus one
+     *          cache line, \p C otherwise.
+     * @tparam T Data type.
+     * @tparam C Column size (or any leading dimension to be adjusted).
+     */
+    template <typename T, Index C>
+    struct aliasing_free_ld{
+        static constexpr Index value = ((sizeof(T) * C) % PEANUT_ALIASING_STRIDE == 0) ? C + 64 / sizeof(T) : C;
+    };
+
+    /**
+     * @brief Helper variable template for `aliasing_free_ld<T, C>`.
+     */
+    template <typename T, Index C>
+    constexpr Index aliasing_free_ld_v = aliasing_free_ld<T, C>::value;
+}
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Alignment of `InlineStorage`. If \p Packets is true, it is at
+     *        least the SIMD register width (up to the cache line size) if the
+     *        storage is as large as one register, so that SIMD packets of
+     *        elements never straddle a cache line (e.g., 3x3 float or double
+     *        matrices). Otherwise it is the largest power of two dividing its
+     *        size, which never increases the size of the storage.
+     * @tparam T Data type.
+     * @tparam N Number of elements.
+     * @tparam Packets True if elements are accessed by SIMD packets.
+     */
+    template <typename T, std::size_t N, bool Packets>
+    constexpr std::size_t inline_alignment_v = std::max<std::size_t>(
+            std::clamp<std::size_t>((sizeof(T) * N) & (~(sizeof(T) * N) + 1), alignof(T), 64),
+            (Packets && sizeof(T) * N >= PEANUT_VECTOR_BYTES) ? std::min<std::size_t>(PEANUT_VECTOR_BYTES, 64) : 1);
+
+    /**
+     * @brief Storage which keeps \p N elements in the object itself.
+     * @tparam T Data type.
+     * @tparam N Number of elements.
+     * @tparam Packets True if elements are accessed by SIMD packets. See
+     *                 `inline_alignment_v`.
+     */
+    template <typename T, std::size_t N, bool Packets = true>
+    struct alignas(inline_alignment_v<T, N, Packets>) InlineStorage : public std::array<T, N> {
+        static constexpr std::size_t Alignment = inline_alignment_v<T, N, Packets>;
+    };
+
+    /**
+     * @brief Storage which keeps \p N elements in a heap buffer aligned to
+     *        the cache line. Copy performs a deep copy, and move transfers
+     *        the ownership of the buffer in O(1). The moved-from storage has
+     *        no buffer until it is written again.
+     * @tparam T Data type.
+     * @tparam N Number of elements.
+     */
+    template <typename T, std::size_t N>
+    struct HeapStorage {
+        static constexpr std::size_t Alignment = 64;
+
+        HeapStorage() : ptr{allocate()} {}
+
+        HeapStorage(const HeapStorage &other) : ptr{other.ptr ? allocate() : nullptr} {
+            if (ptr) {
+                std::copy_n(other.ptr, N, ptr);
+            }
+        }
+
+        HeapStorage(HeapStorage &&other) noexcept : ptr{std::exchange(other.ptr, nullptr)} {}
+
+        HeapStorage &operator=(const HeapStorage &other) {
+            if (this != &other && other.ptr) {
+                std::copy_n(other.ptr, N, writable());
+            }
+            return *this;
+        }
+
+        HeapStorage &operator=(HeapStorage &&other) noexcept {
+            std::swap(ptr, other.ptr);
+            return *this;
+        }
+
+        ~HeapStorage() {
+            if (ptr) {
+                ::operator delete(ptr, std::align_val_t{Alignment});
+            }
+        }
+
+        INLINE T *data() { return writable(); }
+        INLINE const T *data() const { return ptr; }
+        INLINE T &operator[](std::size_t i) { return writable()[i]; }
+        INLINE const T &operator[](std::size_t i) const { return ptr[i]; }
+        INLINE T *begin() { return writable(); }
+        INLINE const T *begin() const { return ptr; }
+        INLINE T *end() { return writable() + N; }
+        INLINE const T *end() const { return ptr + N; }
+        static constexpr std::size_t size() { return N; }
+
+    private:
+        static T *allocate() {
+            return static_cast<T *>(::operator new(sizeof(T) * N, std::align_val_t{Alignment}));
+        }
+
+        // Called by every non-const access, which allocates the buffer of
+        // a moved-from storage
+        INLINE T *writable() {
+            if (!ptr) {
+                ptr = allocate();
+            }
+            return ptr;
+        }
+
+        T *ptr;
+    };
+
+    /**
+     * @brief Storage which keeps \p N elements in a reference-counted heap
+     *        buffer aligned to the cache line. Copy shares the buffer in O(1),
+     *        and the buffer is copied when it is accessed through a non-const
+     *        member function while it is shared (copy-on-write).
+     * @details Note that read access through a non-const matrix also
+     *          detaches the buffer, as the storage cannot distinguish it from
+     *          a write. As the returned reference or pointer may be used
+     *          after that, non-const access also marks the storage
+     *          unshareable, and later copies of it perform a deep copy. A
+     *          storage is shareable when it is constructed, or when a buffer
+     *          is assigned to it. A moved-from storage has no buffer until it
+     *          is written again. Sharing the buffer between threads is safe,
+     *          but accessing one `SharedStorage` instance from multiple
+     *          threads is not.
+     * @tparam T Data type.
+     * @tparam N Number of elements.
+     */
+    template <typename T, std::size_t N>
+    struct SharedStorage {
+        static constexpr std::size_t Alignment = 64;
+
+        SharedStorage() : ptr{allocate()} {}
+
+        SharedStorage(const SharedStorage &other) : ptr{other.shareable ? other.ptr : allocate()} {
+            if (other.shareable) {
+                if (ptr) {
+                    header(ptr)->refs.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else {
+                std::copy_n(other.ptr, N, ptr);
+            }
+        }
+
+        SharedStorage(SharedStorage &&other) noexcept : ptr{std::exchange(other.ptr, nullptr)},
+                                                        shareable{std::exchange(other.shareable, true)} {}
+
+        SharedStorage &operator=(const SharedStorage &other) {
+            SharedStorage tmp(other);
+            std::swap(ptr, tmp.ptr);
+            shareable = true;
+            return *this;
+        }
+
+        SharedStorage &operator=(SharedStorage &&other) noexcept {
+            std::swap(ptr, other.ptr);
+            std::swap(shareable, other.shareable);
+            return *this;
+        }
+
+        ~SharedStorage() {
+            release(ptr);
+        }
+
+        INLINE T *data() { detach(); return ptr; }
+        INLINE const T *data() const { return ptr; }
+        INLINE T &operator[](std::size_t i) { detach(); return ptr[i]; }
+        INLINE const T &operator[](std::size_t i) const { return ptr[i]; }
+        INLINE T *begin() { detach(); return ptr; }
+        INLINE const T *begin() const { return ptr; }
+        INLINE T *end() { detach(); return ptr + N; }
+        INLINE const T *end() const { return ptr + N; }
+        static constexpr std::size_t size() { return N; }
+
+        /**
+         * @brief Number of storages sharing the buffer.
+         */
+        std::size_t use_count() const {
+            return ptr ? header(ptr)->refs.load(std::memory_order_relaxed) : 0;
+        }
+
+    private:
+        // Reference count placed right before the elements, so that the
+        // elements keep the alignment of the buffer.
+        struct alignas(Alignment) Header {
+            std::atomic<std::size_t> refs;
+        };
+
+        static Header *header(T *p) {
+            return reinterpret_cast<Header *>(reinterpret_cast<std::byte *>(p) - sizeof(Header));
+        }
+
+        static T *allocate() {
+            void *raw = ::operator new(sizeof(Header) + sizeof(T) * N, std::align_val_t{Alignment});
+            new (raw) Header{1};
+            return reinterpret_cast<T *>(static_cast<std::byte *>(raw) + sizeof(Header));
+        }
+
+        static void release(T *p) {
+            if (p && header(p)->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Header *h = header(p);
+                h->~Header();
+                ::operator delete(static_cast<void *>(h), std::align_val_t{Alignment});
+            }
+        }
+
+        // Called by every non-const access, which also allocates the buffer
+        // of a moved-from storage
+        INLINE void detach() {
+            if (!ptr) {
+                ptr = allocate();
+            }
+            else if (header(ptr)->refs.load(std::memory_order_acquire) != 1) {
+                T *copied = allocate();
+                std::copy_n(ptr, N, copied);
+                release(std::exchange(ptr, copied));
+            }
+            shareable = false;
+        }
+
+        T *ptr;
+        bool shareable = true;
+    };
+
+    /**
+     * @brief Select a storage type for the given storage policy.
+     * @tparam T Data type.
+     * @tparam N Number of elements.
+     * @tparam S Storage policy.
+     * @tparam Packets True if elements are accessed by SIMD packets. Packed
+     *                 matrices set it false to keep their inline storage
+     *                 compact.
+     */
+    template <typename T, std::size_t N, Storage S, bool Packets = true>
+    using storage_t = std::conditional_t<resolve_storage_v<T, N, S> == Storage::Shared,
+                                         SharedStorage<T, N>,
+                      std::conditional_t<resolve_storage_v<T, N, S> == Storage::Heap,
+                                         HeapStorage<T, N>,
+                                         InlineStorage<T, N, Packets>>>;
+}
@@ -25,12 +25,24 @@
 #pragma once
 
 // Standard headers
+#include <cstddef>
 #include <type_traits>
 
 // Peanut headers
+#include <Peanut/impl/common.h>
 
 // Dependencies headers
 
+/**
+ * @brief Threshold of the estimated cost to compute every element of an
+ *        operand lazily, above which the operand is evaluated into a
+ *        temporary instead (See `is_costly`). It can be overridden by
+ *        defining it before including Peanut.
+ */
+#ifndef PEANUT_MATERIALIZE_COST
+#define PEANUT_MATERIALIZE_COST 64
+#endif
+
 namespace Peanut {
 
     template <typename E> struct MatrixExpr;
@@ -56,6 +68,325 @@ namespace Peanut {
 
     // =========================================================================
 
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression's
+     *        size is known at compile-time.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E> requires is_matrix_v<E>
+    struct is_fixed_size{
+        /**
+         * @brief True if neither row nor column size of \p E is `Dynamic`.
+         */
+        static constexpr bool value = (E::Row != Dynamic && E::Col != Dynamic);
+    };
+
+    /**
+     * @brief Helper variable template for `is_fixed_size<E>`.
+     */
+    template <typename E>
+    constexpr bool is_fixed_size_v = is_fixed_size<E>::value;
+
+    // =========================================================================
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        stores only a triangular half of its elements, such as
+     *        `SymmetricMatrix` or `TriangularMatrix`.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E> requires is_matrix_v<E>
+    struct is_packed{
+        /**
+         * @brief True if \p E declares `static constexpr bool Packed = true`.
+         */
+        static constexpr bool value = requires { requires E::Packed; };
+    };
+
+    /**
+     * @brief Helper variable template for `is_packed<E>`.
+     */
+    template <typename E>
+    constexpr bool is_packed_v = is_packed<E>::value;
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        is a packed symmetric matrix, i.e., `SymmetricMatrix`.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E> requires is_matrix_v<E>
+    struct is_symmetric{
+        /**
+         * @brief True if \p E declares `static constexpr bool Symmetric = true`.
+         */
+        static constexpr bool value = requires { requires E::Packed && E::Symmetric; };
+    };
+
+    /**
+     * @brief Helper variable template for `is_symmetric<E>`.
+     */
+    template <typename E>
+    constexpr bool is_symmetric_v = is_symmetric<E>::value;
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        is a leaf of expression tree, i.e., a plain matrix or a view
+     *        which refers its elements directly without computation, such as
+     *        `Matrix`, `DynMatrix` or `Map`.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E> requires is_matrix_v<E>
+    struct is_leaf{
+        /**
+         * @brief True if \p E declares `static constexpr bool Leaf = true`.
+         */
+        static constexpr bool value = requires { requires E::Leaf; };
+    };
+
+    /**
+     * @brief Helper variable template for `is_leaf<E>`.
+     */
+    template <typename E>
+    constexpr bool is_leaf_v = is_leaf<E>::value;
+
+    /**
+     * @brief Compile-time structure which gives a type to store given Peanut
+     *        matrix expression as an operand of another expression.
+     * @details Leaves (See `is_leaf`) are stored by const reference, as they
+     *          outlive expressions built from them in usual. Other expressions
+     *          are stored by value, since they are mostly temporaries which
+     *          would dangle otherwise (e.g., `auto e = T(a + b);`). Views are
+     *          stored by value as well by specialization (See `Map`).
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E>
+    struct nested{
+        using type = std::conditional_t<is_leaf_v<E>, const E &, const E>;
+    };
+
+    /**
+     * @brief Helper alias template for `nested<E>`.
+     */
+    template <typename E>
+    using nested_t = typename nested<E>::type;
+
+    // =========================================================================
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        is linearly accessible, i.e., its elements can be accessed by a
+     *        flat index `coeff(i)` in its `StorageOrder` without padding.
+     * @details Plain matrices without row padding are linearly accessible,
+     *          and element-wise expressions are linearly accessible if all of
+     *          their operands are and share the same storage order.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E> requires is_matrix_v<E>
+    struct is_linear{
+        /**
+         * @brief True if \p E declares `static constexpr bool Linear = true`.
+         */
+        static constexpr bool value = requires { requires E::Linear; };
+    };
+
+    /**
+     * @brief Helper variable template for `is_linear<E>`.
+     */
+    template <typename E>
+    constexpr bool is_linear_v = is_linear<E>::value;
+
+    /**
+     * @brief Compile-time checking structure if two Peanut matrix expressions
+     *        are linearly accessible with the same flat index.
+     * @tparam E1 Arbitrary Peanut matrix expression.
+     * @tparam E2 Arbitrary Peanut matrix expression.
+     */
+    template <typename E1, typename E2> requires is_matrix_v<E1> && is_matrix_v<E2>
+    struct is_linear_pair{
+        /**
+         * @brief True if both are linearly accessible and have the same `StorageOrder`.
+         */
+        static constexpr bool value = requires {
+            requires E1::Linear && E2::Linear && (E1::StorageOrder == E2::StorageOrder);
+        };
+    };
+
+    /**
+     * @brief Helper variable template for `is_linear_pair<E1, E2>`.
+     */
+    template <typename E1, typename E2>
+    constexpr bool is_linear_pair_v = is_linear_pair<E1, E2>::value;
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        can be evaluated by SIMD packets, i.e., it is linearly accessible
+     *        and provides `packet(i)` which returns `Impl::Packet<Type>` of
+     *        elements from flat index `i`.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E> requires is_matrix_v<E>
+    struct is_vectorizable{
+        /**
+         * @brief True if \p E declares `static constexpr bool Vectorizable = true`.
+         */
+        static constexpr bool value = requires { requires E::Linear && E::Vectorizable; };
+    };
+
+    /**
+     * @brief Helper variable template for `is_vectorizable<E>`.
+     */
+    template <typename E>
+    constexpr bool is_vectorizable_v = is_vectorizable<E>::value;
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix stores
+     *        its elements aligned to `Impl::Packet<Type>`, so that packets
+     *        at flat indices which are multiples of the packet size can be
+     *        loaded and stored by aligned instructions.
+     * @tparam M Arbitrary Peanut matrix.
+     */
+    template <typename M> requires is_matrix_v<M>
+    struct is_packet_aligned{
+        /**
+         * @brief True if \p M declares `static constexpr bool PacketAligned = true`.
+         */
+        static constexpr bool value = requires { requires M::Vectorizable && M::PacketAligned; };
+    };
+
+    /**
+     * @brief Helper variable template for `is_packet_aligned<M>`.
+     */
+    template <typename M>
+    constexpr bool is_packet_aligned_v = is_packet_aligned<M>::value;
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        is a product (`Impl::MatrixMult`), or an element-wise expression
+     *        on exactly one product such as `A * B + C`, so that element-wise
+     *        operations can be applied as an epilogue of the product kernel.
+     * @details Such expression provides `product()` which returns the product,
+     *          and `epilogue(r, c, p)` which returns its element given `p`,
+     *          the element of the product at the same position.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E> requires is_matrix_v<E>
+    struct has_epilogue{
+        /**
+         * @brief True if \p E declares `static constexpr bool Epilogue = true`.
+         */
+        static constexpr bool value = requires { requires E::Epilogue; };
+    };
+
+    /**
+     * @brief Helper variable template for `has_epilogue<E>`.
+     */
+    template <typename E>
+    constexpr bool has_epilogue_v = has_epilogue<E>::value;
+
+    /**
+     * @brief Storage order of given Peanut matrix expression, which is
+     *        `Layout::RowMajor` unless it declares `StorageOrder`.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E>
+    constexpr Layout storage_order_v = [](){
+        if constexpr (requires { E::StorageOrder; }) {
+            return E::StorageOrder;
+        }
+        else {
+            return Layout::RowMajor;
+        }
+    }();
+
+    // =========================================================================
+
+    /**
+     * @brief Size used by cost estimation in place of a size which is
+     *        `Dynamic`, i.e., a size unknown at compile-time is regarded as large.
+     */
+    template <Index N>
+    constexpr std::size_t cost_extent_v = (N == Dynamic) ? 1024 : N;
+
+    /**
+     * @brief Compile-time estimated cost to compute an element of given Peanut
+     *        matrix expression by `operator()`, in the number of scalar
+     *        operations. It is 0 for leaves (See `is_leaf`) and expressions
+     *        holding their result, and `Cost` declared by \p E otherwise
+     *        (e.g., the inner size for a product, plus one for each
+     *        element-wise operation).
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E>
+    constexpr std::size_t cost_v = [](){
+        if constexpr (requires { E::Cost; }) {
+            return std::size_t(E::Cost);
+        }
+        else {
+            return std::size_t(0);
+        }
+    }();
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        is costly to be computed lazily by its parent, i.e., its cost
+     *        (See `cost_v`) multiplied by \p Reads, the number of times the
+     *        parent reads each of its elements, exceeds
+     *        `PEANUT_MATERIALIZE_COST`. Such operand is evaluated into a
+     *        temporary instead (See `Impl::MatrixMult`, `Impl::lazy_or_shared`).
+     * @tparam E Arbitrary Peanut matrix expression.
+     * @tparam Reads Number of reads of each element, which may be `Dynamic`.
+     */
+    template <typename E, Index Reads = 1> requires is_matrix_v<E>
+    struct is_costly{
+        /**
+         * @brief True if \p E is not a leaf and `cost_v<E> * Reads > PEANUT_MATERIALIZE_COST`.
+         */
+        static constexpr bool value = !is_leaf_v<E> && cost_v<E> * cost_extent_v<Reads> > PEANUT_MATERIALIZE_COST;
+    };
+
+    /**
+     * @brief Helper variable template for `is_costly<E, Reads>`.
+     */
+    template <typename E, Index Reads = 1>
+    constexpr bool is_costly_v = is_costly<E, Reads>::value;
+
+    // =========================================================================
+
+    /**
+     * @brief Compile-time structure which merges two sizes which must be equal.
+     * @details `value` is \p N1 unless it is `Dynamic`, \p N2 otherwise.
+     */
+    template <Index N1, Index N2>
+    struct common_size{
+        static constexpr Index value = (N1 != Dynamic) ? N1 : N2;
+    };
+
+    /**
+     * @brief Helper variable template for `common_size<N1, N2>`.
+     */
+    template <Index N1, Index N2>
+    constexpr Index common_size_v = common_size<N1, N2>::value;
+
+    // =========================================================================
+
+    /**
+     * @brief Compile-time structure which gives a plain matrix type to
+     *        evaluate given Peanut matrix expression into. It is `Matrix`
+     *        for fixed-size expressions and `DynMatrix` otherwise, and is
+     *        defined in `dyn_matrix.h`.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E, bool Fixed = is_fixed_size_v<E>>
+    struct eval_type;
+
+    /**
+     * @brief Helper alias template for `eval_type<E>`.
+     */
+    template <typename E>
+    using eval_t = typename eval_type<E>::type;
+
+    // =========================================================================
+
     /**
      * @brief Compile-time checking structure if two Peanut matrix expression type has same size.
      * @tparam E1 Arbitrary Peanut matrix expression.
@@ -65,8 +396,11 @@ namespace Peanut {
     struct is_equal_size_mat{
         /**
          * @brief True if rows and cols of \p E1 and \p E2 are equal.
+         *        `Dynamic` sizes are considered as equal to any size, and
+         *        are checked in runtime.
          */
-        static constexpr bool value = (E1::Row == E2::Row && E1::Col == E2::Col);
+        static constexpr bool value = (E1::Row == E2::Row || E1::Row == Dynamic || E2::Row == Dynamic) &&
+                                      (E1::Col == E2::Col || E1::Col == Dynamic || E2::Col == Dynamic);
     };
 
     /**
@@ -0,0 +1,620 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix.h>
+#include <Peanut/impl/matrix_storage.h>
+#include <Peanut/impl/matrix_type_traits.h>
+
+// Dependencies headers
+
+namespace Peanut {
+
+    /**
+     * @brief Triangular half of a square matrix.
+     */
+    enum class Triangle {
+        Upper,  // Elements on and above the diagonal
+        Lower   // Elements on and below the diagonal
+    };
+
+    /**
+     * @brief Triangular matrix which stores only `N*(N+1)/2` elements of its
+     *        triangle, row by row. Elements in the other half are zero and
+     *        are not stored.
+     * @details Construction from an arbitrary matrix expression evaluates
+     *          only the elements of the triangle, and the other half of the
+     *          expression is ignored. Products with a triangular matrix skip
+     *          the zero half (See `Impl::MatrixPackedMult`).
+     *
+     *     Peanut::UpperTriangularMatrix<float, 3> u{1.0f, 2.0f, 3.0f,
+     *                                                     4.0f, 5.0f,
+     *                                                           6.0f};
+     *     Peanut::Matrix<float, 3, 3> m = u * u;
+     *
+     * @tparam T Type of elements.
+     * @tparam N Row and column size.
+     * @tparam U Stored triangle. See `Triangle`.
+     */
+    template<typename T, Index N, Triangle U>
+        requires std::is_arithmetic_v<T> && (N > 0)
+    struct TriangularMatrix : public MatrixExpr<TriangularMatrix<T, N, U>>{
+
+        /**
+         * @brief Data type. See the detailed description of \p MatrixExpr.
+         */
+        using Type = T;
+
+        /**
+         * @brief Row size of the matrix.
+         */
+        static constexpr Index Row = N;
+
+        /**
+         * @brief Column size of the matrix.
+         */
+        static constexpr Index Col = N;
+
+        /**
+         * @brief Storage order of the triangle in `m_data`.
+         */
+        static constexpr Layout StorageOrder = Layout::RowMajor;
+
+        /**
+         * @brief Only a triangle is stored. See `is_packed`.
+         */
+        static constexpr bool Packed = true;
+
+        /**
+         * @brief Elements are referred directly. See `is_leaf`.
+         */
+        static constexpr bool Leaf = true;
+
+        /**
+         * @brief Number of stored elements.
+         */
+        static constexpr Index Size = N*(N+1)/2;
+
+        /**
+         * @brief Check if the element in \p r 'th row and \p c 'th column is
+         *        stored, i.e., it is in the triangle \p U .
+         * @param r Row index.
+         * @param c Column index.
+         * @return True if the element is stored, false if it is zero.
+         */
+        INLINE static constexpr bool is_stored(Index r, Index c){
+            return (U == Triangle::Upper) ? (r <= c) : (c <= r);
+        }
+
+        /**
+         * @brief Position of the stored element in \p r 'th row and \p c 'th
+         *        column in `m_data`.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Index of `m_data`.
+         */
+        INLINE static constexpr Index index(Index r, Index c){
+            if constexpr (U == Triangle::Upper){
+                return r*(2*N - r + 1)/2 + (c - r);
+            }
+            else{
+                return r*(r+1)/2 + c;
+            }
+        }
+
+        /**
+         * @brief First column index of non-zero elements in \p r 'th row.
+         */
+        INLINE static constexpr Index row_begin(Index r){
+            return (U == Triangle::Upper) ? r : 0;
+        }
+
+        /**
+         * @brief Past-the-last column index of non-zero elements in \p r 'th row.
+         */
+        INLINE static constexpr Index row_end(Index r){
+            return (U == Triangle::Upper) ? N : r + 1;
+        }
+
+        /**
+         * @brief First row index of non-zero elements in \p c 'th column.
+         */
+        INLINE static constexpr Index col_begin(Index c){
+            return (U == Triangle::Upper) ? 0 : c;
+        }
+
+        /**
+         * @brief Past-the-last row index of non-zero elements in \p c 'th column.
+         */
+        INLINE static constexpr Index col_end(Index c){
+            return (U == Triangle::Upper) ? c + 1 : N;
+        }
+
+        /**
+         * @brief Constructor without any initialization
+         */
+        TriangularMatrix() {}
+
+        /**
+         * @brief Constructor with elements of the triangle, row by row.
+         * @param tlist Parameter pack with \p T types.
+         *
+         *     // Lower triangular matrix
+         *     // 1 0 0
+         *     // 2 3 0
+         *     // 4 5 6
+         *     LowerTriangularMatrix<int, 3> mat(1,
+         *                                       2,3,
+         *                                       4,5,6);
+         */
+        template <typename ...TList>
+            requires std::conjunction_v<std::is_same<T, TList>...> &&
+                     (sizeof...(TList) == Size)
+        TriangularMatrix(TList ... tlist) {
+            const T elems[] = {tlist...};
+            memcpy(m_data.data(), elems, sizeof(T)*Size);
+        }
+
+        /**
+         * @brief Constructor from arbitrary Peanut matrix expression. Only
+         *        the elements in the triangle are evaluated.
+         * @param expr Arbitrary Peanut matrix expression.
+         */
+        template<typename E>
+        TriangularMatrix(const MatrixExpr<E> &expr) requires is_equal_type_size_v<E, TriangularMatrix>{
+            const E &e = static_cast<const E&>(expr);
+            Impl::check_equal_size(*this, e);
+            for(Index r=0;r<N;r++){
+                for(Index c=row_begin(r);c<row_end(r);c++){
+                    m_data[index(r, c)] = e(r, c);
+                }
+            }
+        }
+
+        /**
+         * @brief Construct zero matrix.
+         * @return Zero matrix.
+         */
+        static TriangularMatrix zeros() {
+            TriangularMatrix m;
+            memset(m.m_data.data(), 0, sizeof(T)*Size);
+            return m;
+        }
+
+        /**
+         * @brief Construct identity matrix.
+         * @return Identity matrix.
+         */
+        static TriangularMatrix identity() {
+            TriangularMatrix m = zeros();
+            for(Index i=0;i<N;i++){
+                m.m_data[index(i, i)] = static_cast<T>(1);
+            }
+            return m;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::rows()`.
+         * @return \p N
+         */
+        INLINE static constexpr Index rows(){
+            return N;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::cols()`.
+         * @return \p N
+         */
+        INLINE static constexpr Index cols(){
+            return N;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::operator()` which returns rvalue.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Rvalue of an element in \p r 'th Row and \p c 'th column,
+         *         which is zero out of the triangle.
+         */
+        INLINE T operator()(Index r, Index c) const{
+            return is_stored(r, c) ? m_data[index(r, c)] : static_cast<T>(0);
+        }
+
+        /**
+         * @brief Get a reference of element in \p r 'th row and \p c 'th
+         *        column, which must be in the triangle. Unlike `Matrix`,
+         *        `operator()` is read-only since the other half is not stored.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Reference of an element in \p r 'th Row and \p c 'th column.
+         */
+        INLINE T& at(Index r, Index c){
+            assert(is_stored(r, c));
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Check if elements of the matrix overlap the memory [\p begin, \p end).
+         *        It is used to detect aliasing in assignment, and is false for
+         *        different element types at compile-time.
+         * @param begin Pointer to the first element of the memory.
+         * @param end Pointer past the last element of the memory.
+         * @return True if they overlap.
+         */
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const{
+            if constexpr (std::is_same_v<V, T>){
+                const T *p = std::as_const(m_data).data();
+                return Impl::overlaps(p, p + Size, begin, end);
+            }
+            else{
+                return false;
+            }
+        }
+
+        /**
+         * @brief Evaluate as a dense matrix. The zero half is filled without
+         *        reading `m_data`.
+         * @param Evaluated matrix (reference output)
+         */
+        template <typename M> requires is_equal_type_size_v<M, TriangularMatrix>
+        void eval(M &_result) const{
+            if constexpr (!is_fixed_size_v<M>){
+                _result.resize(N, N);
+            }
+            if constexpr (is_unrolled_v<N, N>){
+                // Small matrices are evaluated element by element in unrolled code
+                Impl::evaluate(_result, *this);
+                return;
+            }
+            if constexpr (M::StorageOrder == Layout::RowMajor){
+                for(Index r=0;r<N;r++){
+                    for(Index c=0;c<row_begin(r);c++){
+                        _result(r, c) = static_cast<T>(0);
+                    }
+                    for(Index c=row_begin(r);c<row_end(r);c++){
+                        _result(r, c) = m_data[index(r, c)];
+                    }
+                    for(Index c=row_end(r);c<N;c++){
+                        _result(r, c) = static_cast<T>(0);
+                    }
+                }
+            }
+            else{
+                for(Index c=0;c<N;c++){
+                    for(Index r=0;r<col_begin(c);r++){
+                        _result(r, c) = static_cast<T>(0);
+                    }
+                    for(Index r=col_begin(c);r<col_end(c);r++){
+                        _result(r, c) = m_data[index(r, c)];
+                    }
+                    for(Index r=col_end(c);r<N;r++){
+                        _result(r, c) = static_cast<T>(0);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief An implementation of `operator<<`
+         * @return Given std::ostream
+         */
+        friend std::ostream &operator<<(std::ostream &os, const TriangularMatrix &matrix) {
+            for(Index r=0;r<N;r++){
+                for(Index c=0;c<N;c++){
+                    os << matrix(r, c)<<" ";
+                }
+            }
+            return os;
+        }
+
+        // Elements of the triangle, row by row.
+        Impl::storage_t<T, Size, Storage::Auto, false> m_data;
+    };
+
+    /**
+     * @brief Upper triangular matrix. See `TriangularMatrix`.
+     */
+    template<typename T, Index N>
+    using UpperTriangularMatrix = TriangularMatrix<T, N, Triangle::Upper>;
+
+    /**
+     * @brief Lower triangular matrix. See `TriangularMatrix`.
+     */
+    template<typename T, Index N>
+    using LowerTriangularMatrix = TriangularMatrix<T, N, Triangle::Lower>;
+
+    // =========================================================================
+
+    /**
+     * @brief Symmetric matrix which stores only `N*(N+1)/2` elements of its
+     *        lower triangle, row by row.
+     * @details Element (r, c) and (c, r) share the same storage, so writing
+     *          one of them writes both. Construction from an arbitrary
+     *          matrix expression evaluates only its lower triangle, e.g.,
+     *          a Gram matrix is built with about half of the dot products.
+     *          Products walk the stored triangle once and use each element
+     *          for both of its positions (See `Impl::MatrixPackedMult`).
+     *
+     *     Peanut::Matrix<float, 4, 3> a = ...;
+     *     Peanut::SymmetricMatrix<float, 3> gram = T(a) * a;
+     *
+     * @tparam T Type of elements.
+     * @tparam N Row and column size.
+     */
+    template<typename T, Index N>
+        requires std::is_arithmetic_v<T> && (N > 0)
+    struct SymmetricMatrix : public MatrixExpr<SymmetricMatrix<T, N>>{
+
+        /**
+         * @brief Data type. See the detailed description of \p MatrixExpr.
+         */
+        using Type = T;
+
+        /**
+         * @brief Row size of the matrix.
+         */
+        static constexpr Index Row = N;
+
+        /**
+         * @brief Column size of the matrix.
+         */
+        static constexpr Index Col = N;
+
+        /**
+         * @brief Storage order of the lower triangle in `m_data`.
+         */
+        static constexpr Layout StorageOrder = Layout::RowMajor;
+
+        /**
+         * @brief Only a triangle is stored. See `is_packed`.
+         */
+        static constexpr bool Packed = true;
+
+        /**
+         * @brief Products walk the stored triangle once. See `is_symmetric`.
+         */
+        static constexpr bool Symmetric = true;
+
+        /**
+         * @brief Elements are referred directly. See `is_leaf`.
+         */
+        static constexpr bool Leaf = true;
+
+        /**
+         * @brief Number of stored elements.
+         */
+        static constexpr Index Size = N*(N+1)/2;
+
+        /**
+         * @brief Position of the element in \p r 'th row and \p c 'th column
+         *        in `m_data`.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Index of `m_data`.
+         */
+        INLINE static constexpr Index index(Index r, Index c){
+            return (c <= r) ? r*(r+1)/2 + c : c*(c+1)/2 + r;
+        }
+
+        /**
+         * @brief First column index of non-zero elements in \p r 'th row.
+         */
+        INLINE static constexpr Index row_begin(Index){
+            return 0;
+        }
+
+        /**
+         * @brief Past-the-last column index of non-zero elements in \p r 'th row.
+         */
+        INLINE static constexpr Index row_end(Index){
+            return N;
+        }
+
+        /**
+         * @brief First row index of non-zero elements in \p c 'th column.
+         */
+        INLINE static constexpr Index col_begin(Index){
+            return 0;
+        }
+
+        /**
+         * @brief Past-the-last row index of non-zero elements in \p c 'th column.
+         */
+        INLINE static constexpr Index col_end(Index){
+            return N;
+        }
+
+        /**
+         * @brief Constructor without any initialization
+         */
+        SymmetricMatrix() {}
+
+        /**
+         * @brief Constructor with elements of the lower triangle, row by row.
+         * @param tlist Parameter pack with \p T types.
+         *
+         *     // 1 2 4
+         *     // 2 3 5
+         *     // 4 5 6
+         *     SymmetricMatrix<int, 3> mat(1,
+         *                                 2,3,
+         *                                 4,5,6);
+         */
+        template <typename ...TList>
+            requires std::conjunction_v<std::is_same<T, TList>...> &&
+                     (sizeof...(TList) == Size)
+        SymmetricMatrix(TList ... tlist) {
+            const T elems[] = {tlist...};
+            memcpy(m_data.data(), elems, sizeof(T)*Size);
+        }
+
+        /**
+         * @brief Constructor from arbitrary Peanut matrix expression, which
+         *        is assumed to be symmetric. Only the elements in its lower
+         *        triangle are evaluated.
+         * @param expr Arbitrary Peanut matrix expression.
+         */
+        template<typename E>
+        SymmetricMatrix(const MatrixExpr<E> &expr) requires is_equal_type_size_v<E, SymmetricMatrix>{
+            const E &e = static_cast<const E&>(expr);
+            Impl::check_equal_size(*this, e);
+            for(Index r=0;r<N;r++){
+                for(Index c=0;c<=r;c++){
+                    m_data[index(r, c)] = e(r, c);
+                }
+            }
+        }
+
+        /**
+         * @brief Construct zero matrix.
+         * @return Zero matrix.
+         */
+        static SymmetricMatrix zeros() {
+            SymmetricMatrix m;
+            memset(m.m_data.data(), 0, sizeof(T)*Size);
+            return m;
+        }
+
+        /**
+         * @brief Construct identity matrix.
+         * @return Identity matrix.
+         */
+        static SymmetricMatrix identity() {
+            SymmetricMatrix m = zeros();
+            for(Index i=0;i<N;i++){
+                m.m_data[index(i, i)] = static_cast<T>(1);
+            }
+            return m;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::rows()`.
+         * @return \p N
+         */
+        INLINE static constexpr Index rows(){
+            return N;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::cols()`.
+         * @return \p N
+         */
+        INLINE static constexpr Index cols(){
+            return N;
+        }
+
+        /**
+         * @brief Implementation of `MatrixExpr::operator()` which returns rvalue.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Rvalue of an element in \p r 'th Row and \p c 'th column.
+         */
+        INLINE T operator()(Index r, Index c) const{
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Get a reference of element in \p r 'th row and \p c 'th
+         *        column, which is shared with (\p c, \p r) element.
+         * @param r Row index.
+         * @param c Column index.
+         * @return Reference of an element in \p r 'th Row and \p c 'th column.
+         */
+        INLINE T& operator()(Index r, Index c){
+            return m_data[index(r, c)];
+        }
+
+        /**
+         * @brief Check if elements of the matrix overlap the memory [\p begin, \p end).
+         *        It is used to detect aliasing in assignment, and is false for
+         *        different element types at compile-time.
+         * @param begin Pointer to the first element of the memory.
+         * @param end Pointer past the last element of the memory.
+         * @return True if they overlap.
+         */
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const{
+            if constexpr (std::is_same_v<V, T>){
+                const T *p = std::as_const(m_data).data();
+                return Impl::overlaps(p, p + Size, begin, end);
+            }
+            else{
+                return false;
+            }
+        }
+
+        /**
+         * @brief Evaluate as a dense matrix. Each stored element is read once
+         *        and written to both halves.
+         * @param Evaluated matrix (reference output)
+         */
+        template <typename M> requires is_equal_type_size_v<M, SymmetricMatrix>
+        void eval(M &_result) const{
+            if constexpr (!is_fixed_size_v<M>){
+                _result.resize(N, N);
+            }
+            if constexpr (is_unrolled_v<N, N>){
+                // Small matrices are evaluated element by element in unrolled code
+                Impl::evaluate(_result, *this);
+                return;
+            }
+            Index i = 0;
+            for(Index r=0;r<N;r++){
+                for(Index c=0;c<=r;c++){
+                    const T v = m_data[i++];
+                    _result(r, c) = v;
+                    _result(c, r) = v;
+                }
+            }
+        }
+
+        /**
+         * @brief An implementation of `operator<<`
+         * @return Given std::ostream
+         */
+        friend std::ostream &operator<<(std::ostream &os, const SymmetricMatrix &matrix) {
+            for(Index r=0;r<N;r++){
+                for(Index c=0;c<N;c++){
+                    os << matrix(r, c)<<" ";
+                }
+            }
+            return os;
+        }
+
+        // Elements of the lower triangle, row by row.
+        Impl::storage_t<T, Size, Storage::Auto, false> m_data;
+    };
+}
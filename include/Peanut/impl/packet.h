@@ -0,0 +1,247 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#pragma once
+
+// Standard headers
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief SIMD register holding `Size` elements of \p T , used to evaluate
+     *        matrix expressions explicitly vectorized (See `is_vectorizable`).
+     * @details This primary template is used for types and targets without
+     *          SIMD support, and is disabled. Specializations exist for
+     *          `float` and `double` on SSE2/AVX, and for `int` on SSE4.1/AVX2.
+     *          Every specialization provides `load()`, `set1()`, `store()`,
+     *          arithmetic operators, `min()`, `max()` and `abs()`, and
+     *          floating point ones provide `operator/()` and `sqrt()`.
+     *          `load_aligned()` and `store_aligned()` require an address
+     *          aligned to `sizeof(Packet)`.
+     * @tparam T Element type.
+     */
+    template <typename T>
+    struct Packet {
+        static constexpr bool Enabled = false;
+        static constexpr Index Size = 1;
+    };
+
+#if defined(__AVX__)
+    template <>
+    struct Packet<float> {
+        static constexpr bool Enabled = true;
+        static constexpr Index Size = 8;
+        __m256 v;
+
+        INLINE static Packet load(const float *p) { return {_mm256_loadu_ps(p)}; }
+        INLINE static Packet load_aligned(const float *p) { return {_mm256_load_ps(p)}; }
+        INLINE static Packet set1(float x) { return {_mm256_set1_ps(x)}; }
+        INLINE void store(float *p) const { _mm256_storeu_ps(p, v); }
+        INLINE void store_aligned(float *p) const { _mm256_store_ps(p, v); }
+        INLINE friend Packet operator+(Packet a, Packet b) { return {_mm256_add_ps(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a, Packet b) { return {_mm256_sub_ps(a.v, b.v)}; }
+        INLINE friend Packet operator*(Packet a, Packet b) { return {_mm256_mul_ps(a.v, b.v)}; }
+        INLINE friend Packet operator/(Packet a, Packet b) { return {_mm256_div_ps(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a) { return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+        INLINE friend Packet sqrt(Packet a) { return {_mm256_sqrt_ps(a.v)}; }
+        INLINE friend Packet min(Packet a, Packet b) { return {_mm256_min_ps(a.v, b.v)}; }
+        INLINE friend Packet max(Packet a, Packet b) { return {_mm256_max_ps(a.v, b.v)}; }
+        INLINE friend Packet abs(Packet a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+    };
+
+    template <>
+    struct Packet<double> {
+        static constexpr bool Enabled = true;
+        static constexpr Index Size = 4;
+        __m256d v;
+
+        INLINE static Packet load(const double *p) { return {_mm256_loadu_pd(p)}; }
+        INLINE static Packet load_aligned(const double *p) { return {_mm256_load_pd(p)}; }
+        INLINE static Packet set1(double x) { return {_mm256_set1_pd(x)}; }
+        INLINE void store(double *p) const { _mm256_storeu_pd(p, v); }
+        INLINE void store_aligned(double *p) const { _mm256_store_pd(p, v); }
+        INLINE friend Packet operator+(Packet a, Packet b) { return {_mm256_add_pd(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a, Packet b) { return {_mm256_sub_pd(a.v, b.v)}; }
+        INLINE friend Packet operator*(Packet a, Packet b) { return {_mm256_mul_pd(a.v, b.v)}; }
+        INLINE friend Packet operator/(Packet a, Packet b) { return {_mm256_div_pd(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a) { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+        INLINE friend Packet sqrt(Packet a) { return {_mm256_sqrt_pd(a.v)}; }
+        INLINE friend Packet min(Packet a, Packet b) { return {_mm256_min_pd(a.v, b.v)}; }
+        INLINE friend Packet max(Packet a, Packet b) { return {_mm256_max_pd(a.v, b.v)}; }
+        INLINE friend Packet abs(Packet a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+    };
+#elif defined(__SSE2__) || defined(_M_X64)
+    template <>
+    struct Packet<float> {
+        static constexpr bool Enabled = true;
+        static constexpr Index Size = 4;
+        __m128 v;
+
+        INLINE static Packet load(const float *p) { return {_mm_loadu_ps(p)}; }
+        INLINE static Packet load_aligned(const float *p) { return {_mm_load_ps(p)}; }
+        INLINE static Packet set1(float x) { return {_mm_set1_ps(x)}; }
+        INLINE void store(float *p) const { _mm_storeu_ps(p, v); }
+        INLINE void store_aligned(float *p) const { _mm_store_ps(p, v); }
+        INLINE friend Packet operator+(Packet a, Packet b) { return {_mm_add_ps(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a, Packet b) { return {_mm_sub_ps(a.v, b.v)}; }
+        INLINE friend Packet operator*(Packet a, Packet b) { return {_mm_mul_ps(a.v, b.v)}; }
+        INLINE friend Packet operator/(Packet a, Packet b) { return {_mm_div_ps(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a) { return {_mm_xor_ps(a.v, _mm_set1_ps(-0.0f))}; }
+        INLINE friend Packet sqrt(Packet a) { return {_mm_sqrt_ps(a.v)}; }
+        INLINE friend Packet min(Packet a, Packet b) { return {_mm_min_ps(a.v, b.v)}; }
+        INLINE friend Packet max(Packet a, Packet b) { return {_mm_max_ps(a.v, b.v)}; }
+        INLINE friend Packet abs(Packet a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+    };
+
+    template <>
+    struct Packet<double> {
+        static constexpr bool Enabled = true;
+        static constexpr Index Size = 2;
+        __m128d v;
+
+        INLINE static Packet load(const double *p) { return {_mm_loadu_pd(p)}; }
+        INLINE static Packet load_aligned(const double *p) { return {_mm_load_pd(p)}; }
+        INLINE static Packet set1(double x) { return {_mm_set1_pd(x)}; }
+        INLINE void store(double *p) const { _mm_storeu_pd(p, v); }
+        INLINE void store_aligned(double *p) const { _mm_store_pd(p, v); }
+        INLINE friend Packet operator+(Packet a, Packet b) { return {_mm_add_pd(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a, Packet b) { return {_mm_sub_pd(a.v, b.v)}; }
+        INLINE friend Packet operator*(Packet a, Packet b) { return {_mm_mul_pd(a.v, b.v)}; }
+        INLINE friend Packet operator/(Packet a, Packet b) { return {_mm_div_pd(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a) { return {_mm_xor_pd(a.v, _mm_set1_pd(-0.0))}; }
+        INLINE friend Packet sqrt(Packet a) { return {_mm_sqrt_pd(a.v)}; }
+        INLINE friend Packet min(Packet a, Packet b) { return {_mm_min_pd(a.v, b.v)}; }
+        INLINE friend Packet max(Packet a, Packet b) { return {_mm_max_pd(a.v, b.v)}; }
+        INLINE friend Packet abs(Packet a) { return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)}; }
+    };
+#endif
+
+#if defined(__AVX2__)
+    template <>
+    struct Packet<int> {
+        static constexpr bool Enabled = true;
+        static constexpr Index Size = 8;
+        __m256i v;
+
+        INLINE static Packet load(const int *p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p))}; }
+        INLINE static Packet load_aligned(const int *p) { return {_mm256_load_si256(reinterpret_cast<const __m256i *>(p))}; }
+        INLINE static Packet set1(int x) { return {_mm256_set1_epi32(x)}; }
+        INLINE void store(int *p) const { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+        INLINE void store_aligned(int *p) const { _mm256_store_si256(reinterpret_cast<__m256i *>(p), v); }
+        INLINE friend Packet operator+(Packet a, Packet b) { return {_mm256_add_epi32(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a, Packet b) { return {_mm256_sub_epi32(a.v, b.v)}; }
+        INLINE friend Packet operator*(Packet a, Packet b) { return {_mm256_mullo_epi32(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a) { return {_mm256_sub_epi32(_mm256_setzero_si256(), a.v)}; }
+        INLINE friend Packet min(Packet a, Packet b) { return {_mm256_min_epi32(a.v, b.v)}; }
+        INLINE friend Packet max(Packet a, Packet b) { return {_mm256_max_epi32(a.v, b.v)}; }
+        INLINE friend Packet abs(Packet a) { return {_mm256_abs_epi32(a.v)}; }
+    };
+#elif defined(__SSE4_1__)
+    template <>
+    struct Packet<int> {
+        static constexpr bool Enabled = true;
+        static constexpr Index Size = 4;
+        __m128i v;
+
+        INLINE static Packet load(const int *p) { return {_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))}; }
+        INLINE static Packet load_aligned(const int *p) { return {_mm_load_si128(reinterpret_cast<const __m128i *>(p))}; }
+        INLINE static Packet set1(int x) { return {_mm_set1_epi32(x)}; }
+        INLINE void store(int *p) const { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+        INLINE void store_aligned(int *p) const { _mm_store_si128(reinterpret_cast<__m128i *>(p), v); }
+        INLINE friend Packet operator+(Packet a, Packet b) { return {_mm_add_epi32(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a, Packet b) { return {_mm_sub_epi32(a.v, b.v)}; }
+        INLINE friend Packet operator*(Packet a, Packet b) { return {_mm_mullo_epi32(a.v, b.v)}; }
+        INLINE friend Packet operator-(Packet a) { return {_mm_sub_epi32(_mm_setzero_si128(), a.v)}; }
+        INLINE friend Packet min(Packet a, Packet b) { return {_mm_min_epi32(a.v, b.v)}; }
+        INLINE friend Packet max(Packet a, Packet b) { return {_mm_max_epi32(a.v, b.v)}; }
+        INLINE friend Packet abs(Packet a) { return {_mm_abs_epi32(a.v)}; }
+    };
+#endif
+
+    /**
+     * @brief Helper variable template which checks if `Packet<T>` is enabled.
+     */
+    template <typename T>
+    constexpr bool has_packet_v = Packet<T>::Enabled;
+
+    /**
+     * @brief Helper variable template which checks if `Packet<T>` supports
+     *        `operator/()` and `sqrt()`.
+     */
+    template <typename T>
+    constexpr bool has_packet_div_v = has_packet_v<T> && std::is_floating_point_v<T>;
+
+    /**
+     * @brief Helper variable template which checks if `packet_cast<To>()` is
+     *        available from `Packet<From>`. Identity and conversions between
+     *        `int` and `float` of the same width are supported.
+     */
+    template <typename From, typename To>
+    constexpr bool is_packet_castable_v = has_packet_v<From> && has_packet_v<To> &&
+                                          (std::is_same_v<From, To> ||
+                                           ((std::is_same_v<From, int> && std::is_same_v<To, float>) ||
+                                            (std::is_same_v<From, float> && std::is_same_v<To, int>)) &&
+                                           Packet<From>::Size == Packet<To>::Size);
+
+    /**
+     * @brief Convert elements of a packet as `static_cast<To>` does.
+     * @tparam To Target element type.
+     * @tparam From Source element type.
+     * @param p Source packet.
+     * @return Converted packet.
+     */
+    template <typename To, typename From> requires is_packet_castable_v<From, To>
+    INLINE Packet<To> packet_cast(const Packet<From> &p) {
+        if constexpr (std::is_same_v<From, To>) {
+            return p;
+        }
+        else if constexpr (std::is_same_v<To, float>) {
+            if constexpr (Packet<To>::Size == 8) {
+                return {_mm256_cvtepi32_ps(p.v)};
+            }
+            else {
+                return {_mm_cvtepi32_ps(p.v)};
+            }
+        }
+        else {
+            if constexpr (Packet<To>::Size == 8) {
+                return {_mm256_cvttps_epi32(p.v)};
+            }
+            else {
+                return {_mm_cvttps_epi32(p.v)};
+            }
+        }
+    }
+}
@@ -24,9 +24,11 @@
 #pragma once
 
 // Standard headers
+#include <stdexcept>
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
 
 // Dependencies headers
@@ -38,14 +40,22 @@ namespace Peanut::Impl {
      * @tparam col_start Lower column index of the block
      * @tparam row_size Row size of the block
      * @tparam col_size Column size of the block
-     * @tparam E Matrix expression type.
+     * @tparam E Matrix expression type. If its size is `Dynamic`, the range
+     *           is checked in runtime.
      */
     template<Index row_start, Index col_start, Index row_size, Index col_size, typename E>
-        requires is_matrix_v<E> && is_between_v<0, row_start, E::Row> && is_between_v<0, col_start, E::Col> &&
-                 is_between_v<0, row_start + row_size, E::Row + 1> && is_between_v<0, col_start + col_size, E::Col + 1>
+        requires is_matrix_v<E> && (!is_fixed_size_v<E> ||
+                 (is_between_v<0, row_start, E::Row> && is_between_v<0, col_start, E::Col> &&
+                  is_between_v<0, row_start + row_size, E::Row + 1> && is_between_v<0, col_start + col_size, E::Col + 1>))
     struct MatrixBlock : public MatrixExpr<MatrixBlock<row_start, col_start, row_size, col_size, E>> {
         using Type = typename E::Type;
-        MatrixBlock(const E &x) : x{x} {}
+        MatrixBlock(const E &x) : x{x} {
+            if constexpr (!is_fixed_size_v<E>) {
+                if (row_start + row_size > x.rows() || col_start + col_size > x.cols()) {
+                    throw std::out_of_range("Block out of range");
+                }
+            }
+        }
 
         // Static polymorphism implementation of MatrixExpr
         INLINE auto operator()(Index r, Index c) const {
@@ -54,16 +64,28 @@ namespace Peanut::Impl {
 
         static constexpr Index Row = row_size;
         static constexpr Index Col = col_size;
+        static constexpr std::size_t Cost = cost_v<E>;
 
-        void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = x(row_start + i, col_start + j);
-                }
-            }
+        INLINE static constexpr Index rows() {
+            return Row;
+        }
+
+        INLINE static constexpr Index cols() {
+            return Col;
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixBlock>
+        void eval(M &_result) const {
+            evaluate(_result, *this);
         }
 
-        const E &x;
+        nested_t<E> x;
     };
 }
 
@@ -89,8 +111,9 @@ namespace Peanut {
      *
      */
     template<Index row_start, Index col_start, Index row_size, Index col_size, typename E>
-        requires is_matrix_v<E> && is_between_v<0, row_start, E::Row> && is_between_v<0, col_start, E::Col> &&
-                 is_between_v<0, row_start + row_size, E::Row + 1> && is_between_v<0, col_start + col_size, E::Col + 1>
+        requires is_matrix_v<E> && (!is_fixed_size_v<E> ||
+                 (is_between_v<0, row_start, E::Row> && is_between_v<0, col_start, E::Col> &&
+                  is_between_v<0, row_start + row_size, E::Row + 1> && is_between_v<0, col_start + col_size, E::Col + 1>))
     Impl::MatrixBlock<row_start, col_start, row_size, col_size, E> Block(const MatrixExpr<E> &x) {
         return Impl::MatrixBlock<row_start, col_start, row_size, col_size, E>(static_cast<const E &>(x));
     }
@@ -27,6 +27,7 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
 
 // Dependencies headers
@@ -40,7 +41,7 @@ namespace Peanut::Impl {
      * @tparam E Matrix expression type.
      */
     template<typename E>
-        requires is_matrix_v<E> && is_square_v<E>
+        requires is_matrix_v<E> && is_square_v<E> && is_fixed_size_v<E>
     struct MatrixCofactor : public MatrixExpr<MatrixCofactor<E>> {
         using Type = typename E::Type;
         MatrixCofactor(const E &_x) {
@@ -68,12 +69,24 @@ namespace Peanut::Impl {
         static constexpr Index Row = E::Row;
         static constexpr Index Col = E::Col;
 
-        void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = mat_eval(i, j);
-                }
-            }
+        INLINE static constexpr Index rows() {
+            return Row;
+        }
+
+        INLINE static constexpr Index cols() {
+            return Col;
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *, const V *) const {
+            // Operands are evaluated in the constructor
+            return false;
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixCofactor>
+        void eval(M &_result) const {
+            evaluate(_result, *this);
         }
 
         Peanut::Matrix<Type, Row, Col> mat_eval;
@@ -87,7 +100,7 @@ namespace Peanut{
      * @tparam E Matrix expression type.
      * @return Constructed `Impl::MatrixCofactor` instance
      */
-    template <typename E> requires is_matrix_v<E> && is_square_v<E>
+    template <typename E> requires is_matrix_v<E> && is_square_v<E> && is_fixed_size_v<E>
     Impl::MatrixCofactor<E> Cofactor(const MatrixExpr<E> &x){
         return Impl::MatrixCofactor<E>(static_cast<const E&>(x));
     }
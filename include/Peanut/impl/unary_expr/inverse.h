@@ -27,6 +27,7 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
 #include <Peanut/impl/unary_expr/transpose.h>
 #include <Peanut/impl/unary_expr/cofactor.h>
@@ -42,7 +43,7 @@ namespace Peanut::Impl {
      * @tparam E Matrix expression type.
      */
     template<typename E>
-        requires is_matrix_v<E> && is_square_v<E>
+        requires is_matrix_v<E> && is_square_v<E> && is_fixed_size_v<E>
     struct MatrixInverse : public MatrixExpr<MatrixInverse<E>> {
         using Type = Float;
         MatrixInverse(const E &_x) : x{_x} {
@@ -58,16 +59,29 @@ namespace Peanut::Impl {
 
         static constexpr Index Row = E::Row;
         static constexpr Index Col = E::Col;
+        static constexpr std::size_t Cost = 1;
 
-        void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = invdet * cofactor_eval(j, i);
-                }
-            }
+        INLINE static constexpr Index rows() {
+            return Row;
         }
 
-        const E &x;// used for optimization
+        INLINE static constexpr Index cols() {
+            return Col;
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *, const V *) const {
+            // Operands are evaluated in the constructor
+            return false;
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixInverse>
+        void eval(M &_result) const {
+            evaluate(_result, *this);
+        }
+
+        nested_t<E> x;// used for optimization
         Matrix<Float, Row, Col> cofactor_eval;
         Float invdet;
     };
@@ -81,7 +95,7 @@ namespace Peanut {
      * @return Constructed `Impl::MatrixInverse` instance
      */
     template<typename E>
-        requires is_matrix_v<E> && is_square_v<E>
+        requires is_matrix_v<E> && is_square_v<E> && is_fixed_size_v<E>
     Impl::MatrixInverse<E> Inverse(const MatrixExpr<E> &x) {
         return Impl::MatrixInverse<E>(static_cast<const E &>(x));
     }
@@ -93,11 +107,27 @@ namespace Peanut {
      *        it does not construct a `MatrixInverse` instance.
      * @tparam E Matrix expression type.
      * @param x `MatrixInverse<E>` type matrix expression.
-     * @return Input of the given parameter `x`
+     * @return Input of the given parameter `x`, referred if it is a leaf
+     *         (See `nested`).
      */
     template<typename E>
-        requires is_matrix_v<E> && is_square_v<E>
-    const E& Inverse(const Impl::MatrixInverse<E> &x) {
+        requires is_matrix_v<E> && is_square_v<E> && is_fixed_size_v<E>
+    nested_t<E> Inverse(const Impl::MatrixInverse<E> &x) {
         return static_cast<const E &>(x.x);
     }
+
+    /**
+     * @brief Template specialization of `Inverse()` which represents an
+     *        inverse of a transpose of a matrix. It is rewritten as a
+     *        transpose of an inverse (i.e., Inv(T(A)) = T(Inv(A))), so that
+     *        the input is evaluated without transposing it first.
+     * @tparam E Matrix expression type.
+     * @param x `MatrixTranspose<E>` type matrix expression.
+     * @return Constructed `Impl::MatrixTranspose` instance
+     */
+    template<typename E>
+        requires is_matrix_v<E> && is_square_v<E> && is_fixed_size_v<E>
+    auto Inverse(const Impl::MatrixTranspose<E> &x) {
+        return T(Inverse(static_cast<const E &>(x.x)));
+    }
 }
@@ -0,0 +1,305 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+// Standard headers
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
+#include <Peanut/impl/matrix_reduction.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+#include <Peanut/impl/unary_expr/shared.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Expression class which represents a row-wise or column-wise
+     *        reduction, e.g., `RowwiseSum()` gives `R x 1` sums of each row
+     *        and `ColwiseSum()` gives `1 x C` sums of each column.
+     * @details Each element reduces a line of the operand by
+     *          `reduce_range()`. When the whole expression is evaluated and
+     *          the reduced lines cross the storage order of the operand
+     *          (e.g., column-wise reduction of a row-major matrix), lines are
+     *          accumulated into a scratch line one after another instead,
+     *          which reads the operand in its storage order and is vectorized
+     *          if the operand is (See `is_vectorizable`).
+     * @tparam Rowwise True to reduce each row, false to reduce each column.
+     * @tparam R Reduction policy (e.g., `SumReduction`).
+     * @tparam E Matrix expression type.
+     */
+    template<bool Rowwise, typename R, typename E>
+        requires is_matrix_v<E>
+    struct MatrixPartialReduction : public MatrixExpr<MatrixPartialReduction<Rowwise, R, E>> {
+        using Type = std::conditional_t<R::Floating, Float, typename E::Type>;
+        MatrixPartialReduction(const E &x) : x{x} {
+            if constexpr (E::Row == Dynamic || E::Col == Dynamic) {
+                if (x.rows() == 0 || x.cols() == 0) {
+                    throw std::invalid_argument("Reduction of empty matrix");
+                }
+            }
+        }
+
+        // Static polymorphism implementation of MatrixExpr
+        INLINE Type operator()(Index r, Index c) const {
+            using T = typename E::Type;
+            if constexpr (Rowwise) {
+                return R::finalize(reduce_range(x.cols(), [&](Index i) { return static_cast<T>(x(r, i)); },
+                                                R::map, R::fold), x.cols());
+            }
+            else {
+                return R::finalize(reduce_range(x.rows(), [&](Index i) { return static_cast<T>(x(i, c)); },
+                                                R::map, R::fold), x.rows());
+            }
+        }
+
+        static constexpr Index Row = Rowwise ? E::Row : 1;
+        static constexpr Index Col = Rowwise ? 1 : E::Col;
+        static constexpr std::size_t Cost = cost_extent_v<Rowwise ? E::Col : E::Row> * (cost_v<E> + 1);
+
+        INLINE Index rows() const {
+            return Rowwise ? x.rows() : 1;
+        }
+
+        INLINE Index cols() const {
+            return Rowwise ? 1 : x.cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixPartialReduction>
+        void eval(M &_result) const {
+            if constexpr ((storage_order_v<E> == Layout::RowMajor) != Rowwise) {
+                if constexpr (M::Row == Dynamic || M::Col == Dynamic) {
+                    _result.resize(rows(), cols());
+                }
+                accumulate_lines(_result);
+            }
+            else {
+                evaluate(_result, *this);
+            }
+        }
+
+        nested_t<E> x;
+
+    private:
+        // Accumulate lines of x crossing the reduced direction (e.g., rows of
+        // x for a column-wise reduction) into a scratch line.
+        template <typename M>
+        INLINE void accumulate_lines(M &_result) const {
+            using T = typename E::Type;
+            constexpr Index N = Rowwise ? E::Row : E::Col;
+            const Index size = Rowwise ? x.rows() : x.cols();
+            const Index lines = Rowwise ? x.cols() : x.rows();
+            auto at = [&](Index l, Index i) {
+                return static_cast<T>(Rowwise ? x(i, l) : x(l, i));
+            };
+
+            std::conditional_t<N == Dynamic, std::vector<T>, std::array<T, N>> acc{};
+            if constexpr (N == Dynamic) {
+                acc.resize(size);
+            }
+            Index vec_size = 0;
+            if constexpr (is_vectorizable_v<E> && has_packet_v<T>) {
+                // x is linearly accessible in its storage order, where lines
+                // are contiguous
+                constexpr Index P = Packet<T>::Size;
+                vec_size = size / P * P;
+                for (Index i = 0; i < vec_size; i += P) {
+                    R::map(x.packet(i)).store(acc.data() + i);
+                }
+                for (Index l = 1; l < lines; l++) {
+                    for (Index i = 0; i < vec_size; i += P) {
+                        R::fold(Packet<T>::load(acc.data() + i), R::map(x.packet(l * size + i))).store(acc.data() + i);
+                    }
+                }
+            }
+            for (Index i = vec_size; i < size; i++) {
+                acc[i] = R::map(at(0, i));
+            }
+            for (Index l = 1; l < lines; l++) {
+                for (Index i = vec_size; i < size; i++) {
+                    acc[i] = R::fold(acc[i], R::map(at(l, i)));
+                }
+            }
+
+            for (Index i = 0; i < size; i++) {
+                _result(Rowwise ? i : 0, Rowwise ? 0 : i) = R::finalize(acc[i], lines);
+            }
+        }
+    };
+
+    /**
+     * @brief Construct `MatrixPartialReduction`, whose operand is evaluated
+     *        once if it is costly (See `lazy_or_shared`).
+     */
+    template<bool Rowwise, typename R, typename E>
+    auto partial_reduction(const E &x) {
+        decltype(auto) e = lazy_or_shared<1>(x);
+        return MatrixPartialReduction<Rowwise, R, std::remove_cvref_t<decltype(e)>>(e);
+    }
+}
+
+namespace Peanut {
+    /**
+     * @brief Sum of each row of a matrix expression, as `R x 1` matrix
+     *        expression. See `Impl::MatrixPartialReduction`.
+     *
+     *     Matrix<int, 2, 3> mat{1,2,3,
+     *                           4,5,6};
+     *
+     *     Matrix<int, 2, 1> ev = RowwiseSum(mat);
+     *     // 6
+     *     // 15
+     *
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto RowwiseSum(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<true, Impl::SumReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Sum of each column of a matrix expression, as `1 x C` matrix
+     *        expression. See `Impl::MatrixPartialReduction`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto ColwiseSum(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<false, Impl::SumReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Float type mean of each row of a matrix expression. See `RowwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto RowwiseMean(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<true, Impl::MeanReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Float type mean of each column of a matrix expression. See `ColwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto ColwiseMean(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<false, Impl::MeanReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Minimum element of each row of a matrix expression. See `RowwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto RowwiseMin(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<true, Impl::MinReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Minimum element of each column of a matrix expression. See `ColwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto ColwiseMin(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<false, Impl::MinReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Maximum element of each row of a matrix expression. See `RowwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto RowwiseMax(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<true, Impl::MaxReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Maximum element of each column of a matrix expression. See `ColwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto ColwiseMax(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<false, Impl::MaxReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Sum of squares of each row of a matrix expression. See `RowwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto RowwiseSquaredNorm(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<true, Impl::SquaredNormReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Sum of squares of each column of a matrix expression. See `ColwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto ColwiseSquaredNorm(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<false, Impl::SquaredNormReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Float type L2 norm of each row of a matrix expression. See `RowwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto RowwiseNorm(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<true, Impl::NormReduction>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Float type L2 norm of each column of a matrix expression. See `ColwiseSum()`.
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixPartialReduction` instance
+     */
+    template<typename E> requires is_matrix_v<E>
+    auto ColwiseNorm(const MatrixExpr<E> &x) {
+        return Impl::partial_reduction<false, Impl::NormReduction>(static_cast<const E &>(x));
+    }
+}
@@ -0,0 +1,202 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+// Standard headers
+#include <memory>
+#include <type_traits>
+
+// Peanut headers
+#include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
+#include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+
+// Dependencies headers
+
+namespace Peanut::Impl {
+
+    /**
+     * @brief Expression class which represents a common subexpression, which
+     *        is evaluated once and shared by every place it appears in.
+     * @details The input expression is evaluated during construction, and
+     *          copies of the instance (e.g., as operands stored by value in
+     *          an expression tree, See `nested`) share the evaluated result.
+     *          It is a leaf (See `is_leaf`), so products refer it without
+     *          evaluating it again.
+     * @tparam E Matrix expression type.
+     */
+    template<typename E>
+        requires is_matrix_v<E>
+    struct MatrixShared : public MatrixExpr<MatrixShared<E>> {
+        using Type = typename E::Type;
+        using Result = eval_t<E>;
+
+        MatrixShared(const E &x) : result{std::make_shared<Result>(x)} {}
+
+        // Static polymorphism implementation of MatrixExpr
+        INLINE Type operator()(Index r, Index c) const {
+            return (*result)(r, c);
+        }
+
+        static constexpr Index Row = E::Row;
+        static constexpr Index Col = E::Col;
+        static constexpr bool Leaf = true;
+        static constexpr bool Linear = is_linear_v<Result>;
+        static constexpr Layout StorageOrder = storage_order_v<Result>;
+        static constexpr bool Vectorizable = is_vectorizable_v<Result>;
+
+        // Flat index access, available if the expression is linearly accessible
+        INLINE Type coeff(Index i) const requires Linear {
+            return result->coeff(i);
+        }
+
+        // SIMD packet access, available if the expression is vectorizable
+        template <bool Aligned = false>
+        INLINE Packet<Type> packet(Index i) const requires Vectorizable {
+            return result->template packet<Aligned>(i);
+        }
+
+        INLINE Index rows() const {
+            return result->rows();
+        }
+
+        INLINE Index cols() const {
+            return result->cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return result->aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixShared>
+        void eval(M &_result) const {
+            result->eval(_result);
+        }
+
+        std::shared_ptr<const Result> result;
+    };
+
+    /**
+     * @brief Operand of an expression which reads each of its elements
+     *        \p Reads times. It is evaluated once into `MatrixShared` if it
+     *        is costly to be computed lazily (See `is_costly`), and referred
+     *        as it is otherwise.
+     * @tparam Reads Number of reads of each element, which may be `Dynamic`.
+     * @tparam E Matrix expression type.
+     * @param x Operand.
+     * @return `MatrixShared<E>` instance, or `x` itself
+     */
+    template <Index Reads, typename E>
+    decltype(auto) lazy_or_shared(const E &x) {
+        if constexpr (is_costly_v<E, Reads>) {
+            return MatrixShared<E>(x);
+        }
+        else {
+            return x;
+        }
+    }
+
+    /**
+     * @brief Operand of an element-wise expression, which is evaluated once
+     *        if it is costly (See `lazy_or_shared`) unless \p Fused is true,
+     *        i.e., it is the only operand including a product, which is fused
+     *        with the expression instead (See `has_epilogue`).
+     * @tparam E Matrix expression type.
+     * @tparam Fused True if the product in `x` is fused with the expression.
+     * @param x Operand.
+     * @return `MatrixShared<E>` instance, or `x` itself
+     */
+    template <typename E, bool Fused = has_epilogue_v<E>>
+    decltype(auto) elementwise_operand(const E &x) {
+        if constexpr (Fused) {
+            return x;
+        }
+        else {
+            return lazy_or_shared<1>(x);
+        }
+    }
+
+    /**
+     * @brief Construct an element-wise binary expression `Op` with operands
+     *        given by `elementwise_operand`. If both operands include a
+     *        product, the right hand side one is evaluated so that the other
+     *        one is fused.
+     * @tparam Op Element-wise binary expression class template (e.g., `MatrixSum`).
+     * @tparam E1 Left hand side matrix expression type.
+     * @tparam E2 Right hand side matrix expression type.
+     * @return Constructed `Op` instance
+     */
+    template <template <typename, typename> typename Op, typename E1, typename E2>
+    auto make_elementwise(const E1 &x, const E2 &y) {
+        decltype(auto) b = elementwise_operand<E2, has_epilogue_v<E2> && !has_epilogue_v<E1>>(y);
+        using Y = std::remove_cvref_t<decltype(b)>;
+        decltype(auto) a = elementwise_operand<E1, has_epilogue_v<E1> && !has_epilogue_v<Y>>(x);
+        using X = std::remove_cvref_t<decltype(a)>;
+        return Op<X, Y>(a, b);
+    }
+}
+
+namespace Peanut {
+
+    /**
+     * @brief Specialization of `nested` which stores `Impl::MatrixShared` by
+     *        value, since it only holds a pointer to the shared result.
+     */
+    template<typename E>
+    struct nested<Impl::MatrixShared<E>>{
+        using type = const Impl::MatrixShared<E>;
+    };
+
+    /**
+     * @brief Common subexpression which is evaluated once, and reused
+     *        wherever it appears. See `Impl::MatrixShared`.
+     *
+     *     auto sq = Shared(a * a);
+     *     Matrix<float, 4, 4> ret = a + a - sq * (a + a - sq);
+     *
+     * @tparam E Matrix expression type.
+     * @return Constructed `Impl::MatrixShared` instance
+     */
+    template<typename E>
+        requires is_matrix_v<E>
+    Impl::MatrixShared<E> Shared(const MatrixExpr<E> &x) {
+        return Impl::MatrixShared<E>(static_cast<const E &>(x));
+    }
+
+    /**
+     * @brief Template specialization of `Shared()` for already shared
+     *        expression, which returns a copy sharing the same result.
+     * @tparam E Matrix expression type.
+     * @param x `MatrixShared<E>` type matrix expression.
+     * @return Copy of the given parameter `x`
+     */
+    template<typename E>
+        requires is_matrix_v<E>
+    Impl::MatrixShared<E> Shared(const Impl::MatrixShared<E> &x) {
+        return x;
+    }
+}
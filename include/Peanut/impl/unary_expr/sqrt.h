@@ -27,7 +27,10 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/packet.h>
+#include <Peanut/impl/unary_expr/shared.h>
 
 // Dependencies headers
 
@@ -49,16 +52,54 @@ namespace Peanut::Impl {
 
         static constexpr Index Row = E::Row;
         static constexpr Index Col = E::Col;
+        static constexpr bool Linear = is_linear_v<E>;
+        static constexpr Layout StorageOrder = storage_order_v<E>;
+        static constexpr bool Vectorizable = is_vectorizable_v<E> && std::is_same_v<typename E::Type, Float> && has_packet_div_v<Float>;
+        static constexpr bool Epilogue = has_epilogue_v<E>;
+        static constexpr std::size_t Cost = cost_v<E> + 1;
 
-        void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = std::sqrt(x(i, j));
-                }
-            }
+        // Flat index access, available if the expression is linearly accessible
+        INLINE Type coeff(Index i) const requires Linear {
+            return std::sqrt(x.coeff(i));
         }
 
-        const E &x;
+        // SIMD packet access, available if the expression is vectorizable
+        template <bool Aligned = false>
+        INLINE Packet<Type> packet(Index i) const requires Vectorizable {
+            return sqrt(x.template packet<Aligned>(i));
+        }
+
+        // Element given the product element at the same position, available
+        // if the expression has a product to be fused (See `has_epilogue`)
+        template <typename P>
+        INLINE Type epilogue(Index r, Index c, const P &p) const requires Epilogue {
+            return std::sqrt(x.epilogue(r, c, p));
+        }
+
+        INLINE const auto &product() const requires Epilogue {
+            return x.product();
+        }
+
+        INLINE Index rows() const {
+            return x.rows();
+        }
+
+        INLINE Index cols() const {
+            return x.cols();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixESqrt>
+        void eval(M &_result) const {
+            evaluate(_result, *this);
+        }
+
+        nested_t<E> x;
     };
 }
 
@@ -71,7 +112,8 @@ namespace Peanut {
      */
     template<typename E>
         requires is_matrix_v<E>
-    Impl::MatrixESqrt<E> Sqrt(const MatrixExpr<E> &x) {
-        return Impl::MatrixESqrt<E>(static_cast<const E &>(x));
+    auto Sqrt(const MatrixExpr<E> &x) {
+        decltype(auto) e = Impl::elementwise_operand(static_cast<const E &>(x));
+        return Impl::MatrixESqrt<std::remove_cvref_t<decltype(e)>>(e);
     }
 }
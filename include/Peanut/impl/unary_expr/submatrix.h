@@ -27,6 +27,7 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
 
 // Dependencies headers
@@ -53,16 +54,28 @@ namespace Peanut::Impl {
 
         static constexpr Index Row = E::Row - 1;
         static constexpr Index Col = E::Col - 1;
+        static constexpr std::size_t Cost = cost_v<E>;
 
-        void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = x(i < row_ex ? i : i + 1, j < col_ex ? j : j + 1);
-                }
-            }
+        INLINE static constexpr Index rows() {
+            return Row;
         }
 
-        const E &x;
+        INLINE static constexpr Index cols() {
+            return Col;
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixSub>
+        void eval(M &_result) const {
+            evaluate(_result, *this);
+        }
+
+        nested_t<E> x;
     };
 }
 
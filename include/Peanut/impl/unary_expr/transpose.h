@@ -27,7 +27,9 @@
 
 // Peanut headers
 #include <Peanut/impl/common.h>
+#include <Peanut/impl/matrix_eval.h>
 #include <Peanut/impl/matrix_type_traits.h>
+#include <Peanut/impl/unary_expr/shared.h>
 
 // Dependencies headers
 
@@ -50,20 +52,78 @@ namespace Peanut::Impl {
 
         static constexpr Index Row = E::Col;
         static constexpr Index Col = E::Row;
+        static constexpr std::size_t Cost = cost_v<E>;
 
-        void eval(Matrix<Type, Row, Col> &_result) const {
-            for (int i=0;i<Row;i++) {
-                for (int j=0;j<Col;j++) {
-                    _result(i,j) = x(j, i);
-                }
-            }
+        INLINE Index rows() const {
+            return x.cols();
         }
 
-        const E &x;
+        INLINE Index cols() const {
+            return x.rows();
+        }
+
+        // Check if the expression reads elements in [begin, end)
+        template <typename V>
+        INLINE bool aliases(const V *begin, const V *end) const {
+            return x.aliases(begin, end);
+        }
+
+        template <typename M> requires is_equal_type_size_v<M, MatrixTranspose>
+        void eval(M &_result) const {
+            evaluate(_result, *this);
+        }
+
+        nested_t<E> x;
     };
 }
 
 namespace Peanut{
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        is a transpose (`Impl::MatrixTranspose`).
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E>
+    struct is_transpose{
+        static constexpr bool value = false;
+    };
+
+    template <typename E>
+    struct is_transpose<Impl::MatrixTranspose<E>>{
+        static constexpr bool value = true;
+    };
+
+    /**
+     * @brief Helper variable template for `is_transpose<E>`.
+     */
+    template <typename E>
+    constexpr bool is_transpose_v = is_transpose<E>::value;
+
+    /**
+     * @brief Compile-time checking structure if given Peanut matrix expression
+     *        is a transpose of a leaf (See `is_leaf`), which can be read from
+     *        the storage of the leaf without evaluation.
+     * @tparam E Arbitrary Peanut matrix expression.
+     */
+    template <typename E>
+    struct is_transposed_leaf{
+        static constexpr bool value = false;
+    };
+
+    template <typename E>
+    struct is_transposed_leaf<Impl::MatrixTranspose<E>>{
+        /**
+         * @brief True if \p E is a leaf.
+         */
+        static constexpr bool value = is_leaf_v<E>;
+    };
+
+    /**
+     * @brief Helper variable template for `is_transposed_leaf<E>`.
+     */
+    template <typename E>
+    constexpr bool is_transposed_leaf_v = is_transposed_leaf<E>::value;
+
     /**
      * @brief Transpose operation of matrix. See `Impl::MatrixTranspose`
      *        and https://en.wikipedia.org/wiki/Transpose for details.
@@ -72,8 +132,9 @@ namespace Peanut{
      */
     template<typename E>
         requires is_matrix_v<E>
-    Impl::MatrixTranspose<E> T(const MatrixExpr<E> &x) {
-        return Impl::MatrixTranspose<E>(static_cast<const E &>(x));
+    auto T(const MatrixExpr<E> &x) {
+        decltype(auto) e = Impl::lazy_or_shared<1>(static_cast<const E &>(x));
+        return Impl::MatrixTranspose<std::remove_cvref_t<decltype(e)>>(e);
     }
 
     /**
@@ -82,11 +143,12 @@ namespace Peanut{
      *        a input of the given parameter (i.e., T(T(x)) = x).
      * @tparam E Matrix expression type.
      * @param x `MatrixTranspose<E>` type matrix expression.
-     * @return Input of the given parameter `x`
+     * @return Input of the given parameter `x`, referred if it is a leaf
+     *         (See `nested`).
      */
     template<typename E>
         requires is_matrix_v<E>
-    const E& T(const Impl::MatrixTranspose<E> &x) {
+    nested_t<E> T(const Impl::MatrixTranspose<E> &x) {
         return static_cast<const E &>(x.x);
     }
 
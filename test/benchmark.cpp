@@ -61,6 +61,17 @@ Peanut::Matrix<float, 300, 300> create_test_matrix_300_300(float val) {
     return test;
 }
 
+template <Peanut::Index N, Peanut::Index LD = 0>
+Peanut::Matrix<float, N, N, Peanut::Storage::Auto, LD> create_test_matrix(float val) {
+    Peanut::Matrix<float, N, N, Peanut::Storage::Auto, LD> test;
+    for (Peanut::Index r = 0; r < N; ++r) {
+        for (Peanut::Index c = 0; c < N; ++c) {
+            test(r, c) = val++;
+        }
+    }
+    return test;
+}
+
 
 TEST_CASE("benchmark"){
     auto test = create_test_matrix44(1.0f);
@@ -75,12 +86,72 @@ TEST_CASE("benchmark"){
         return ret;
     };
 
-#ifdef __APPLE__
+    BENCHMARK("middle matrix, shared product"){
+        auto sq = Peanut::Shared(test2 * test2);
+        Peanut::Matrix<float, 100, 100> ret = test2 + test2 - sq * (test2 + test2 - sq);
+        return ret;
+    };
+
     auto test3 = create_test_matrix_300_300(1.0f);
     BENCHMARK("large matrix"){
         Peanut::Matrix<float, 300, 300> ret = test3 + test3 - (test3 * test3) * (test3 + test3 - test3 * test3);
         return ret;
     };
-#endif
 }
 
+// Power-of-two sizes walk columns through a few cache sets only, which
+// padded leading dimensions avoid. Run with `PeanutTest "[leading_dimension]"`.
+TEST_CASE("benchmark : leading dimension", "[.][leading_dimension]"){
+    using Padded512 = Peanut::PaddedMatrix<float, 512, 512>;
+    auto test500 = create_test_matrix<500>(1.0f);
+    auto test512 = create_test_matrix<512>(1.0f);
+    auto padded512 = create_test_matrix<512, Padded512::Stride>(1.0f);
+
+    BENCHMARK("500x500 product"){
+        Peanut::Matrix<float, 500, 500> ret = test500 * test500;
+        return ret;
+    };
+
+    BENCHMARK("512x512 product"){
+        Peanut::Matrix<float, 512, 512> ret = test512 * test512;
+        return ret;
+    };
+
+    BENCHMARK("512x512 product, padded"){
+        Padded512 ret = padded512 * padded512;
+        return ret;
+    };
+
+    BENCHMARK("500x500 transpose"){
+        Peanut::Matrix<float, 500, 500> ret = T(test500);
+        return ret;
+    };
+
+    BENCHMARK("512x512 transpose"){
+        Peanut::Matrix<float, 512, 512> ret = T(test512);
+        return ret;
+    };
+
+    BENCHMARK("512x512 transpose, padded"){
+        Padded512 ret = T(padded512);
+        return ret;
+    };
+}
+
+TEST_CASE("benchmark : multi-output evaluation", "[.][eval_all]"){
+    auto a = create_test_matrix<1000>(1.0f);
+    auto b = create_test_matrix<1000>(2.0f);
+    Peanut::Matrix<float, 1000, 1000> sum, diff, prod;
+
+    BENCHMARK("separate assignments"){
+        sum = a + b;
+        diff = a - b;
+        prod = a % b;
+        return sum(0, 0) + diff(0, 0) + prod(0, 0);
+    };
+
+    BENCHMARK("EvalAll"){
+        Peanut::EvalAll(Peanut::Assign(sum, a + b), Peanut::Assign(diff, a - b), Peanut::Assign(prod, a % b));
+        return sum(0, 0) + diff(0, 0) + prod(0, 0);
+    };
+}
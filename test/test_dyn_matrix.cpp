@@ -0,0 +1,134 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+// Standard headers
+#include <stdexcept>
+#include <vector>
+
+// Peanut headers
+#include <Peanut.h>
+
+// Dependencies headers
+#include "catch_amalgamated.hpp"
+
+
+TEST_CASE("DynMatrix : construction"){
+    Peanut::DynMatrix<int> mat(2, 3, {1,2,3,
+                                      4,5,6});
+    CHECK(mat.rows() == 2);
+    CHECK(mat.cols() == 3);
+    CHECK(mat(0, 2) == 3);
+    CHECK(mat(1, 0) == 4);
+
+    auto zero = Peanut::DynMatrix<float>::zeros(3, 2);
+    CHECK(zero.rows() == 3);
+    CHECK(zero(2, 1) == Catch::Approx(0.0f));
+
+    auto ident = Peanut::DynMatrix<int>::identity(3);
+    CHECK(ident(0, 0) == 1);
+    CHECK(ident(0, 1) == 0);
+    CHECK(ident(2, 2) == 1);
+
+    CHECK_THROWS_AS(Peanut::DynMatrix<int>(2, 2, {1,2,3}), std::invalid_argument);
+}
+
+TEST_CASE("DynMatrix : conversion from and to Matrix"){
+    Peanut::Matrix<int, 2, 2> fixed{1,2,
+                                    3,4};
+    Peanut::DynMatrix<int> dyn = fixed;
+    CHECK(dyn.rows() == 2);
+    CHECK(dyn.cols() == 2);
+    CHECK(dyn(1, 0) == 3);
+
+    Peanut::Matrix<int, 2, 2> back = dyn;
+    CHECK(back(0, 1) == 2);
+    CHECK(back(1, 1) == 4);
+
+    Peanut::DynMatrix<int> wrong(3, 2);
+    CHECK_THROWS_AS((Peanut::Matrix<int, 2, 2>(wrong)), std::invalid_argument);
+}
+
+TEST_CASE("DynMatrix : expressions"){
+    using namespace Peanut;
+    DynMatrix<int> a(2, 3, {1,2,3,
+                            4,5,6});
+    DynMatrix<int> b(3, 2, {1,2,
+                            3,4,
+                            5,6});
+    Matrix<int, 2, 3> fixed{1,1,1,
+                            1,1,1};
+
+    SECTION("Element-wise operations"){
+        DynMatrix<int> sum = a + fixed - a;
+        CHECK(sum.rows() == 2);
+        CHECK(sum.cols() == 3);
+        CHECK(sum(1, 2) == 1);
+
+        Matrix<int, 2, 3> emult = (a % a) * 2;
+        CHECK(emult(1, 2) == 72);
+
+        DynMatrix<int> neg = -a;
+        CHECK(neg(0, 1) == -2);
+
+        CHECK_THROWS_AS(a + b, std::invalid_argument);
+    }
+
+    SECTION("Multiplication and transpose"){
+        DynMatrix<int> prod = a * b;
+        CHECK(prod.rows() == 2);
+        CHECK(prod.cols() == 2);
+        CHECK(prod(0, 0) == 22);
+        CHECK(prod(0, 1) == 28);
+        CHECK(prod(1, 0) == 49);
+        CHECK(prod(1, 1) == 64);
+
+        Matrix<int, 2, 2> mixed = fixed * b;
+        CHECK(mixed(0, 0) == 9);
+        CHECK(mixed(1, 1) == 12);
+
+        DynMatrix<int> t = T(a);
+        CHECK(t.rows() == 3);
+        CHECK(t.cols() == 2);
+        CHECK(t(2, 0) == 3);
+
+        DynMatrix<int> tprod = T(b) * T(a);
+        CHECK(tprod(1, 0) == 28);
+
+        CHECK_THROWS_AS(a * a, std::invalid_argument);
+    }
+
+    SECTION("Block"){
+        Matrix<int, 2, 2> block = Block<0, 1, 2, 2>(a);
+        CHECK(block(0, 0) == 2);
+        CHECK(block(1, 1) == 6);
+        CHECK_THROWS_AS((Block<1, 1, 2, 2>(a)), std::out_of_range);
+    }
+
+    SECTION("Column-major"){
+        DynMatrix<int, Layout::ColMajor> col = a * b;
+        CHECK(col.m_data[1] == 49);
+        CHECK(col(0, 1) == 28);
+    }
+}
@@ -0,0 +1,133 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+// Standard headers
+#include <vector>
+
+// Peanut headers
+#include <Peanut.h>
+
+// Dependencies headers
+#include "catch_amalgamated.hpp"
+
+
+TEST_CASE("Map : read"){
+    float buffer[6] = {1,2,3,
+                       4,5,6};
+    Peanut::Map<float, 2, 3> map(buffer);
+    CHECK(map(0, 2) == Catch::Approx(3.0f));
+    CHECK(map(1, 0) == Catch::Approx(4.0f));
+    CHECK(map.data() == buffer);
+
+    Peanut::Matrix<float, 2, 3> mat = map;
+    CHECK(mat(0, 1) == Catch::Approx(2.0f));
+    CHECK(mat(1, 2) == Catch::Approx(6.0f));
+
+    Peanut::Matrix<float, 3, 3> prod = Peanut::T(map) * map;
+    CHECK(prod(0, 0) == Catch::Approx(17.0f));
+    CHECK(prod(1, 2) == Catch::Approx(36.0f));
+    CHECK(prod(2, 2) == Catch::Approx(45.0f));
+
+    Peanut::Matrix<float, 2, 3> sum = map + mat;
+    CHECK(sum(0, 0) == Catch::Approx(2.0f));
+    CHECK(sum(1, 2) == Catch::Approx(12.0f));
+
+    const std::vector<int> vec{1,2,3,4};
+    Peanut::Map<const int, 2, 2> cmap(vec.data());
+    Peanut::Matrix<int, 2, 2> sq = cmap * cmap;
+    CHECK(sq(0, 0) == 7);
+    CHECK(sq(0, 1) == 10);
+    CHECK(sq(1, 0) == 15);
+    CHECK(sq(1, 1) == 22);
+}
+
+TEST_CASE("Map : write"){
+    float buffer[6] = {1,2,3,
+                       4,5,6};
+    Peanut::Map<float, 2, 3> map(buffer);
+    map(0, 0) = 10.0f;
+    CHECK(buffer[0] == Catch::Approx(10.0f));
+
+    Peanut::Matrix<float, 2, 3> ones{1.0f,1.0f,1.0f,
+                                     2.0f,2.0f,2.0f};
+    map = ones * 3.0f;
+    CHECK(buffer[2] == Catch::Approx(3.0f));
+    CHECK(buffer[3] == Catch::Approx(6.0f));
+
+    float other[6] = {};
+    Peanut::Map<float, 2, 3> map2(other);
+    map2 = map;
+    CHECK(other[5] == Catch::Approx(6.0f));
+    CHECK(map2.data() == other);
+
+    Peanut::Matrix<float, 2, 3> mat{1.0f,2.0f,3.0f,4.0f,5.0f,6.0f};
+    map2 = mat;
+    CHECK(other[4] == Catch::Approx(5.0f));
+}
+
+TEST_CASE("Map : strides"){
+    // 3x4 row-major buffer
+    int buffer[12] = {1, 2, 3, 4,
+                      5, 6, 7, 8,
+                      9,10,11,12};
+
+    // Top-left 2x2 block
+    Peanut::Map<int, 2, 2> block(buffer, 4);
+    CHECK(block(0, 1) == 2);
+    CHECK(block(1, 0) == 5);
+    CHECK(block(1, 1) == 6);
+
+    // Every other column
+    Peanut::Map<int, 3, 2> even(buffer, 4, 2);
+    Peanut::Matrix<int, 3, 2> even_mat = even;
+    CHECK(even_mat(0, 1) == 3);
+    CHECK(even_mat(1, 1) == 7);
+    CHECK(even_mat(2, 0) == 9);
+
+    // Column-major interpretation of the same buffer
+    Peanut::Map<int, 4, 3, Peanut::Layout::ColMajor> cm(buffer);
+    Peanut::Matrix<int, 4, 3> cm_mat = cm;
+    CHECK(cm_mat(0, 1) == 5);
+    CHECK(cm_mat(1, 0) == 2);
+    CHECK(cm_mat(3, 2) == 12);
+
+    // Write through a strided view
+    even = Peanut::Matrix<int, 3, 2>::zeros();
+    CHECK(buffer[0] == 0);
+    CHECK(buffer[1] == 2);
+    CHECK(buffer[2] == 0);
+    CHECK(buffer[10] == 0);
+    CHECK(buffer[11] == 12);
+
+    // Matrix::eval() into a non-contiguous destination
+    Peanut::Matrix<int, 2, 2> mat{7,8,9,10};
+    Peanut::Map<int, 2, 2> odd(buffer + 1, 4, 2);
+    odd = mat;
+    CHECK(buffer[1] == 7);
+    CHECK(buffer[2] == 0);
+    CHECK(buffer[3] == 8);
+    CHECK(buffer[5] == 9);
+    CHECK(buffer[7] == 10);
+}
@@ -23,7 +23,10 @@
 //
 
 // Standard headers
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 // Peanut headers
@@ -63,6 +66,232 @@ TEST_CASE("Construct using std::array"){
     CHECK(fltmat(1, 1) == 4.4f);
 }
 
+TEST_CASE("Storage policy"){
+    SECTION("Automatic threshold"){
+        CHECK(Peanut::resolve_storage_v<float, 16, Peanut::Storage::Auto> == Peanut::Storage::Inline);
+        CHECK(Peanut::resolve_storage_v<float, 512 * 512, Peanut::Storage::Auto> == Peanut::Storage::Heap);
+        CHECK(Peanut::resolve_storage_v<float, 512 * 512, Peanut::Storage::Inline> == Peanut::Storage::Inline);
+        CHECK(sizeof(Peanut::Matrix<float, 512, 512>) <= 64);
+    }
+    SECTION("Heap storage"){
+        Peanut::Matrix<int, 2, 2, Peanut::Storage::Heap> mat{1,2,3,4};
+        CHECK(reinterpret_cast<std::uintptr_t>(mat.m_data.data()) % 64 == 0);
+
+        auto copied = mat;
+        copied(0, 0) = 5;
+        CHECK(mat(0, 0) == 1);
+        CHECK(copied(0, 0) == 5);
+
+        const int *ptr = copied.m_data.data();
+        auto moved = std::move(copied);
+        CHECK(moved.m_data.data() == ptr);
+        CHECK(moved(0, 0) == 5);
+        CHECK(moved(1, 1) == 4);
+
+        // Moved-from matrix can be assigned again
+        copied = mat + moved;
+        CHECK(copied(0, 0) == 6);
+        copied = mat;
+        CHECK(copied(1, 1) == 4);
+
+        Peanut::Matrix<int, 2, 2, Peanut::Storage::Heap> sum = mat + moved;
+        CHECK(sum(0, 0) == 6);
+        CHECK(sum(0, 1) == 4);
+        CHECK(sum(1, 0) == 6);
+        CHECK(sum(1, 1) == 8);
+    }
+    SECTION("Shared storage"){
+        // Construction writes elements through non-const access, so the
+        // first copy is a deep copy, which is shareable in turn
+        const Peanut::SharedMatrix<int, 2, 2> init{1,2,3,4};
+        auto mat = init;
+        CHECK(reinterpret_cast<std::uintptr_t>(std::as_const(mat).m_data.data()) % 64 == 0);
+        CHECK(init.m_data.use_count() == 1);
+        CHECK(mat.m_data.use_count() == 1);
+
+        auto copied = mat;
+        CHECK(mat.m_data.use_count() == 2);
+        CHECK(std::as_const(copied).m_data.data() == std::as_const(mat).m_data.data());
+
+        // Reading through const references does not copy
+        const auto &cref = copied;
+        CHECK(cref(1, 1) == 4);
+        CHECK(mat.m_data.use_count() == 2);
+
+        // The first mutation copies
+        copied(0, 0) = 5;
+        CHECK(mat.m_data.use_count() == 1);
+        CHECK(copied.m_data.use_count() == 1);
+        CHECK(std::as_const(mat)(0, 0) == 1);
+        CHECK(std::as_const(copied)(0, 0) == 5);
+
+        auto row_copied = mat;
+        row_copied.set_row(1, Peanut::Matrix<int, 1, 2>{7, 8});
+        CHECK(std::as_const(mat)(1, 0) == 3);
+        CHECK(std::as_const(row_copied)(1, 0) == 7);
+
+        auto col_copied = mat;
+        col_copied.set_col(0, Peanut::Matrix<int, 2, 1>{9, 9});
+        CHECK(std::as_const(mat)(0, 0) == 1);
+        CHECK(std::as_const(col_copied)(1, 0) == 9);
+
+        // Operands of a product are referred, not copied
+        {
+            auto prod = mat * mat;
+            CHECK(mat.m_data.use_count() == 1);
+            Peanut::Matrix<int, 2, 2> result = prod;
+            CHECK(result(0, 0) == 7);
+            CHECK(result(1, 1) == 22);
+        }
+        CHECK(mat.m_data.use_count() == 1);
+
+        Peanut::SharedMatrix<int, 2, 2> assigned;
+        assigned = mat;
+        CHECK(mat.m_data.use_count() == 2);
+        Peanut::SharedMatrix<int, 2, 2> evaluated = mat + mat;
+        CHECK(std::as_const(evaluated)(1, 1) == 8);
+        auto evaluated_copied = evaluated;
+        CHECK(evaluated.m_data.use_count() == 1);
+        auto evaluated_shared = evaluated_copied;
+        CHECK(evaluated_copied.m_data.use_count() == 2);
+
+        // A reference handed out keeps later copies from sharing the buffer
+        int &ref = mat(0, 0);
+        auto copied_after_ref = mat;
+        ref = 5;
+        CHECK(std::as_const(copied_after_ref)(0, 0) == 1);
+        CHECK(std::as_const(mat)(0, 0) == 5);
+        CHECK(mat.m_data.use_count() == 1);
+
+        // Moved-from matrix can be assigned again, and moves allocate nothing
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<Peanut::SharedMatrix<int, 2, 2>>);
+        Peanut::SharedMatrix<int, 2, 2> moved = std::move(mat);
+        CHECK(std::as_const(moved)(0, 0) == 5);
+        CHECK(mat.m_data.use_count() == 0);
+        auto moved_copied = std::as_const(mat);
+        CHECK(moved_copied.m_data.use_count() == 0);
+        mat = moved + moved;
+        CHECK(std::as_const(mat)(0, 0) == 10);
+        CHECK(std::as_const(moved)(0, 0) == 5);
+    }
+    SECTION("Large matrix"){
+        auto large = Peanut::Matrix<float, 512, 512>::identity();
+        Peanut::Matrix<float, 512, 512> result = large * large + large;
+        CHECK(result(0, 0) == Catch::Approx(2.0f));
+        CHECK(result(511, 511) == Catch::Approx(2.0f));
+        CHECK(result(0, 511) == Catch::Approx(0.0f));
+    }
+}
+
+TEST_CASE("Alignment and padded rows"){
+    CHECK(alignof(Peanut::Matrix<float, 4, 4>) == 64);
+    CHECK(alignof(Peanut::Matrix<float, 8, 8>) == 64);
+    CHECK(sizeof(Peanut::Matrix<float, 3, 1>) == sizeof(float) * 3);
+    CHECK(alignof(Peanut::Matrix<float, 3, 3>) >= std::min<std::size_t>(PEANUT_VECTOR_BYTES, 64));
+    CHECK(alignof(Peanut::Matrix<double, 3, 3>) >= std::min<std::size_t>(PEANUT_VECTOR_BYTES, 64));
+    STATIC_CHECK(Peanut::is_packet_aligned_v<Peanut::Matrix<float, 3, 3>>);
+    STATIC_CHECK(Peanut::is_packet_aligned_v<Peanut::Matrix<double, 5, 7>>);
+    STATIC_CHECK_FALSE(Peanut::is_packet_aligned_v<Peanut::DynMatrix<float>>);
+
+    using Padded = Peanut::PaddedMatrix<float, 3, 3>;
+    CHECK(Padded::Stride % (PEANUT_VECTOR_BYTES / sizeof(float)) == 0);
+
+    Peanut::Matrix<float, 3, 3> mat{1.0f, 2.0f, 3.0f,
+                                    4.0f, 5.0f, 6.0f,
+                                    7.0f, 8.0f, 9.0f};
+    Padded padded = mat + mat;
+    for (Peanut::Index r = 0; r < 3; r++) {
+        CHECK(reinterpret_cast<std::uintptr_t>(&padded(r, 0)) % PEANUT_VECTOR_BYTES == 0);
+        for (Peanut::Index c = 0; c < 3; c++) {
+            CHECK(padded(r, c) == Catch::Approx(2.0f * mat(r, c)));
+        }
+    }
+
+    padded.set_row(1, {0.1f, 0.2f, 0.3f});
+    auto r1 = padded.get_row(1);
+    CHECK(r1(0, 0) == Catch::Approx(0.1f));
+    CHECK(r1(0, 1) == Catch::Approx(0.2f));
+    CHECK(r1(0, 2) == Catch::Approx(0.3f));
+    CHECK(padded(2, 0) == Catch::Approx(14.0f));
+
+    auto ident = Padded::identity();
+    auto zero = Padded::zeros();
+    Padded evaluated;
+    (mat * ident).eval(evaluated);
+    for (Peanut::Index r = 0; r < 3; r++) {
+        for (Peanut::Index c = 0; c < 3; c++) {
+            CHECK(ident(r, c) == Catch::Approx(r == c ? 1.0f : 0.0f));
+            CHECK(zero(r, c) == Catch::Approx(0.0f));
+            CHECK(evaluated(r, c) == Catch::Approx(mat(r, c)));
+        }
+    }
+    CHECK(Peanut::Matrix<float, 3, 3>(T(padded))(0, 2) == Catch::Approx(14.0f));
+
+    // Temporaries are not padded, so that they stay linearly accessible
+    using Large = Peanut::Matrix<float, 512, 512>;
+    using LargeTemp = Peanut::eval_t<Peanut::Impl::MatrixMult<Large, Large>>;
+    STATIC_CHECK(LargeTemp::Stride == 512);
+    STATIC_CHECK(Peanut::is_linear_v<LargeTemp>);
+}
+
+TEST_CASE("Column-major layout"){
+    using Peanut::ColMajorMatrix;
+    ColMajorMatrix<int, 2, 3> mat{1,2,3,
+                                  4,5,6};
+    SECTION("Storage order"){
+        CHECK(mat(0, 1) == 2);
+        CHECK(mat(1, 0) == 4);
+        CHECK(mat.m_data[0] == 1);
+        CHECK(mat.m_data[1] == 4);
+        CHECK(mat.m_data[2] == 2);
+
+        ColMajorMatrix<int, 2, 3> from_arr{std::array<int, 6>{1,4,2,5,3,6}};
+        for (Peanut::Index r = 0; r < 2; r++) {
+            for (Peanut::Index c = 0; c < 3; c++) {
+                CHECK(from_arr(r, c) == mat(r, c));
+            }
+        }
+    }
+    SECTION("Row and column access"){
+        auto r1 = mat.get_row(1);
+        auto c2 = mat.get_col(2);
+        CHECK(r1[0] == 4);
+        CHECK(r1[2] == 6);
+        CHECK(c2[0] == 3);
+        CHECK(c2[1] == 6);
+
+        mat.set_row(0, {7, 8, 9});
+        mat.set_col(0, {0, 0});
+        CHECK(mat(0, 0) == 0);
+        CHECK(mat(0, 1) == 8);
+        CHECK(mat(1, 0) == 0);
+        CHECK(mat(1, 2) == 6);
+    }
+    SECTION("Evaluation between layouts"){
+        Peanut::Matrix<int, 3, 2> row_major{1,2,
+                                            3,4,
+                                            5,6};
+        ColMajorMatrix<int, 2, 2> prod = mat * row_major;
+        CHECK(prod(0, 0) == 22);
+        CHECK(prod(0, 1) == 28);
+        CHECK(prod(1, 0) == 49);
+        CHECK(prod(1, 1) == 64);
+
+        ColMajorMatrix<int, 3, 2> sum = T(mat) + row_major;
+        Peanut::Matrix<int, 3, 2> back;
+        sum.eval(back);
+        CHECK(back(0, 0) == 2);
+        CHECK(back(0, 1) == 6);
+        CHECK(back(2, 1) == 12);
+
+        ColMajorMatrix<int, 2, 2> evaluated;
+        (mat * row_major).eval(evaluated);
+        CHECK(evaluated(1, 0) == 49);
+        CHECK(ColMajorMatrix<int, 3, 3>::identity()(2, 2) == 1);
+        CHECK(ColMajorMatrix<float, 2, 2>{1.0f, 2.0f, 3.0f, 4.0f}.det() == Catch::Approx(-2.0f));
+    }
+}
+
 TEST_CASE("Static constructors : zeros()"){
     auto zero_22_int_mat = Peanut::Matrix<int, 2, 2>::zeros();
     CHECK(zero_22_int_mat(0, 0) == 0);
@@ -355,6 +584,339 @@ TEST_CASE("Col getter/setter"){
     }
 }
 
+TEST_CASE("Strided views : row(), col(), block()"){
+    Peanut::Matrix<int, 3, 3> mat{1,2,3,
+                                  4,5,6,
+                                  7,8,9};
+    SECTION("Read"){
+        const auto &cmat = mat;
+        CHECK(cmat.row(1)(0, 2) == 6);
+        CHECK(cmat.col(2)(1, 0) == 6);
+        CHECK(cmat.block<2, 2>(1, 1)(1, 0) == 8);
+
+        Peanut::Matrix<int, 1, 3> sum = mat.row(0) + mat.row(2);
+        CHECK(sum(0, 0) == 8);
+        CHECK(sum(0, 2) == 12);
+
+        Peanut::Matrix<int, 1, 1> dot = mat.row(0) * mat.col(0);
+        CHECK(dot(0, 0) == 30);
+    }
+    SECTION("Write"){
+        mat.row(0) = mat.row(1) * 2;
+        CHECK(mat(0, 0) == 8);
+        CHECK(mat(0, 2) == 12);
+
+        mat.col(1) = Peanut::Matrix<int, 3, 1>::zeros();
+        CHECK(mat(0, 1) == 0);
+        CHECK(mat(2, 1) == 0);
+        CHECK(mat(2, 2) == 9);
+
+        mat.block<2, 2>(1, 1) = Peanut::Matrix<int, 2, 2>::identity();
+        CHECK(mat(1, 1) == 1);
+        CHECK(mat(1, 2) == 0);
+        CHECK(mat(2, 1) == 0);
+        CHECK(mat(2, 2) == 1);
+        CHECK(mat(1, 0) == 4);
+
+        mat.row(2) = mat.row(0);
+        CHECK(mat(2, 0) == 8);
+        CHECK(mat(2, 2) == 12);
+
+        mat.subtract_row(2, 1, 2);
+        CHECK(mat(2, 0) == 0);
+        CHECK(mat(2, 1) == -2);
+        CHECK(mat(2, 2) == 12);
+    }
+    SECTION("Column-major"){
+        Peanut::ColMajorMatrix<int, 3, 3> cm = mat;
+        cm.row(1) = cm.row(1) + cm.row(0);
+        CHECK(cm(1, 0) == 5);
+        CHECK(cm(1, 2) == 9);
+        cm.block<2, 1>(0, 2) = Peanut::Block<1, 0, 2, 1>(cm.col(0));
+        CHECK(cm(0, 2) == 5);
+        CHECK(cm(1, 2) == 7);
+    }
+}
+
+TEST_CASE("Aliasing-aware assignment"){
+    Peanut::Matrix<int, 3, 3, Peanut::Storage::Heap> mat{1,2,3,
+                                                         4,5,6,
+                                                         7,8,9};
+    Peanut::Matrix<int, 3, 3, Peanut::Storage::Heap> other = mat;
+    const int *ptr = mat.m_data.data();
+
+    SECTION("No temporary without aliasing"){
+        mat = Peanut::T(other);
+        CHECK(mat.m_data.data() == ptr);
+        CHECK(mat(0, 1) == 4);
+        CHECK(mat(2, 0) == 3);
+
+        // Element-wise expressions are evaluated in place at compile-time
+        STATIC_CHECK(Peanut::is_linear_pair_v<decltype(mat), decltype(mat + mat * 2)>);
+        mat = mat + mat * 2;
+        CHECK(mat.m_data.data() == ptr);
+        CHECK(mat(0, 1) == 12);
+    }
+    SECTION("Temporary with aliasing"){
+        mat = Peanut::T(mat);
+        CHECK(mat.m_data.data() != ptr);
+        CHECK(mat(0, 1) == 4);
+        CHECK(mat(1, 0) == 2);
+        CHECK(mat(2, 0) == 3);
+        CHECK(mat(0, 2) == 7);
+
+        Peanut::Matrix<int, 2, 2> small{1,2,3,4};
+        small = Peanut::T(Peanut::Block<0, 0, 2, 2>(small)) + small;
+        CHECK(small(0, 1) == 5);
+        CHECK(small(1, 0) == 5);
+    }
+    SECTION("noalias()"){
+        mat.noalias() = Peanut::T(other) + other;
+        CHECK(mat.m_data.data() == ptr);
+        CHECK(mat(0, 1) == 6);
+        CHECK(mat(2, 2) == 18);
+    }
+    SECTION("Views"){
+        mat.block<2, 2>(0, 0) = Peanut::T(mat.block<2, 2>(0, 0));
+        CHECK(mat(0, 1) == 4);
+        CHECK(mat(1, 0) == 2);
+        CHECK(mat(2, 2) == 9);
+
+        mat.row(2) = Peanut::T(mat.col(0));
+        CHECK(mat(2, 0) == 1);
+        CHECK(mat(2, 1) == 2);
+        CHECK(mat(2, 2) == 7);
+    }
+    SECTION("DynMatrix"){
+        Peanut::DynMatrix<int> dyn(2, 3, {1,2,3,
+                                          4,5,6});
+        dyn = Peanut::T(dyn);
+        CHECK(dyn.rows() == 3);
+        CHECK(dyn.cols() == 2);
+        CHECK(dyn(0, 1) == 4);
+        CHECK(dyn(2, 0) == 3);
+    }
+}
+
+TEST_CASE("Compound assignment"){
+    Peanut::Matrix<int, 3, 3, Peanut::Storage::Heap> mat{1,2,3,
+                                                         4,5,6,
+                                                         7,8,9};
+    Peanut::Matrix<int, 3, 3> other{1,0,2,
+                                    0,1,0,
+                                    3,0,1};
+    const int *ptr = mat.m_data.data();
+
+    SECTION("+=, -="){
+        mat += other;
+        CHECK(mat(0, 0) == 2);
+        CHECK(mat(2, 0) == 10);
+        mat -= other * 2;
+        CHECK(mat(0, 0) == 0);
+        CHECK(mat(0, 2) == 1);
+        CHECK(mat(2, 2) == 8);
+        // Aliasing operand
+        mat += Peanut::T(mat);
+        CHECK(mat(0, 1) == 6);
+        CHECK(mat(1, 0) == 6);
+        CHECK(mat(2, 0) == 5);
+        CHECK(mat(0, 2) == 5);
+        CHECK(mat.m_data.data() == ptr);
+    }
+    SECTION("*= matrix"){
+        Peanut::Matrix<int, 3, 3> expected = mat * other;
+        mat *= other;
+        for(int i=0;i<3;i++){
+            for(int j=0;j<3;j++){
+                CHECK(mat(i, j) == expected(i, j));
+            }
+        }
+        CHECK(mat.m_data.data() == ptr);
+
+        // Aliasing operand
+        expected = mat * mat;
+        mat *= mat;
+        for(int i=0;i<3;i++){
+            for(int j=0;j<3;j++){
+                CHECK(mat(i, j) == expected(i, j));
+            }
+        }
+
+        // Non-square left hand side
+        Peanut::Matrix<int, 2, 3> rect{1,2,3,
+                                       4,5,6};
+        rect *= Peanut::T(other) + other;
+        CHECK(rect(0, 0) == 17);
+        CHECK(rect(0, 1) == 4);
+        CHECK(rect(1, 2) == 32);
+    }
+    SECTION("Scalar"){
+        mat *= 3;
+        CHECK(mat(0, 0) == 3);
+        CHECK(mat(2, 2) == 27);
+
+        Peanut::Matrix<float, 2, 2> f{2.f, 4.f, 6.f, 8.f};
+        f /= 2.f;
+        CHECK(f(0, 0) == Catch::Approx(1.f));
+        CHECK(f(1, 1) == Catch::Approx(4.f));
+        f *= 0.5f;
+        CHECK(f(1, 0) == Catch::Approx(1.5f));
+    }
+    SECTION("DynMatrix and views"){
+        Peanut::DynMatrix<int> dyn(2, 2, {1,2,
+                                          3,4});
+        dyn += dyn;
+        CHECK(dyn(1, 1) == 8);
+        dyn *= Peanut::DynMatrix<int>(2, 2, {0,1,
+                                             1,0});
+        CHECK(dyn(0, 0) == 4);
+        CHECK(dyn(0, 1) == 2);
+        CHECK(dyn(1, 0) == 8);
+        CHECK_THROWS(dyn *= Peanut::DynMatrix<int>(2, 3));
+
+        mat.row(0) -= mat.row(1);
+        CHECK(mat(0, 0) == -3);
+        CHECK(mat(0, 2) == -3);
+        mat.col(2) *= 2;
+        CHECK(mat(0, 2) == -6);
+        CHECK(mat(2, 2) == 18);
+    }
+}
+
+TEST_CASE("Size-aware traversal"){
+    STATIC_CHECK(Peanut::is_unrolled_v<3, 3>);
+    STATIC_CHECK(Peanut::is_unrolled_v<4, 4>);
+    STATIC_CHECK_FALSE(Peanut::is_unrolled_v<64, 64>);
+    STATIC_CHECK_FALSE(Peanut::is_unrolled_v<Peanut::Dynamic, 2>);
+
+    // Every index is visited once, in the storage order within a block
+    auto check = [](auto visit, Peanut::Index rows, Peanut::Index cols, bool row_major) {
+        std::vector<int> count(rows * cols, 0);
+        bool ordered = true;
+        Peanut::Index prev_r = 0, prev_c = 0;
+        bool first = true;
+        visit([&](Peanut::Index r, Peanut::Index c) {
+            count[r * cols + c]++;
+            if (!first && rows <= PEANUT_BLOCK_SIZE && cols <= PEANUT_BLOCK_SIZE) {
+                ordered = ordered && (row_major ? (r > prev_r || (r == prev_r && c > prev_c))
+                                                : (c > prev_c || (c == prev_c && r > prev_r)));
+            }
+            first = false;
+            prev_r = r;
+            prev_c = c;
+        });
+        CHECK(ordered);
+        CHECK(std::all_of(count.begin(), count.end(), [](int n) { return n == 1; }));
+    };
+    check([](auto f) { Peanut::for_each_index_sized<Peanut::Layout::RowMajor, 3, 4>(3, 4, f); }, 3, 4, true);
+    check([](auto f) { Peanut::for_each_index_sized<Peanut::Layout::ColMajor, 4, 3>(4, 3, f); }, 4, 3, false);
+    check([](auto f) { Peanut::for_each_index_sized<Peanut::Layout::RowMajor, 20, 20>(20, 20, f); }, 20, 20, true);
+    check([](auto f) { Peanut::for_each_index_sized<Peanut::Layout::RowMajor, 45, 70>(45, 70, f); }, 45, 70, true);
+    check([](auto f) {
+        Peanut::for_each_index_sized<Peanut::Layout::ColMajor, Peanut::Dynamic, Peanut::Dynamic>(70, 45, f);
+    }, 70, 45, false);
+
+    SECTION("Evaluation"){
+        Peanut::Matrix<float, 3, 3> a{1.0f, 2.0f, 3.0f,
+                                      4.0f, 5.0f, 6.0f,
+                                      7.0f, 8.0f, 10.0f};
+        Peanut::Matrix<float, 3, 3> prod = a * a;
+        Peanut::Matrix<float, 3, 3> t = Peanut::T(a) + a;
+        Peanut::Matrix<float, 3, 3, Peanut::Storage::Auto, 0, Peanut::Layout::ColMajor> col = a * a;
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                float expected = 0.0f;
+                for (Peanut::Index k = 0; k < 3; k++) {
+                    expected += a(i, k) * a(k, j);
+                }
+                CHECK(prod(i, j) == Catch::Approx(expected));
+                CHECK(col(i, j) == Catch::Approx(expected));
+                CHECK(t(i, j) == Catch::Approx(a(j, i) + a(i, j)));
+            }
+        }
+
+        Peanut::Matrix<float, 45, 70> b;
+        for (Peanut::Index i = 0; i < 45; i++) {
+            for (Peanut::Index j = 0; j < 70; j++) {
+                b(i, j) = static_cast<float>(i * 70 + j);
+            }
+        }
+        Peanut::Matrix<float, 70, 45> bt = Peanut::T(b);
+        for (Peanut::Index i = 0; i < 70; i++) {
+            for (Peanut::Index j = 0; j < 45; j++) {
+                CHECK(bt(i, j) == b(j, i));
+            }
+        }
+    }
+}
+
+TEST_CASE("Multi-output evaluation"){
+    Peanut::Matrix<float, 5, 7> a, b;
+    for (Peanut::Index i = 0; i < 5; i++) {
+        for (Peanut::Index j = 0; j < 7; j++) {
+            a(i, j) = static_cast<float>(i * 7 + j) * 0.5f;
+            b(i, j) = static_cast<float>((i + 3 * j) % 4) - 1.5f;
+        }
+    }
+    const Peanut::Matrix<float, 5, 7> a0 = a, b0 = b;
+
+    SECTION("Element-wise"){
+        Peanut::Matrix<float, 5, 7> sum, diff, prod;
+        Peanut::DynMatrix<float> dyn;
+        Peanut::EvalAll(Peanut::Assign(sum, a + b), Peanut::Assign(diff, a - b),
+                        Peanut::Assign(prod, a % b), Peanut::Assign(dyn, 2.0f * a));
+        CHECK(dyn.rows() == 5);
+        CHECK(dyn.cols() == 7);
+        for (Peanut::Index i = 0; i < 5; i++) {
+            for (Peanut::Index j = 0; j < 7; j++) {
+                CHECK(sum(i, j) == Catch::Approx(a(i, j) + b(i, j)));
+                CHECK(diff(i, j) == Catch::Approx(a(i, j) - b(i, j)));
+                CHECK(prod(i, j) == Catch::Approx(a(i, j) * b(i, j)));
+                CHECK(dyn(i, j) == Catch::Approx(2.0f * a(i, j)));
+            }
+        }
+    }
+    SECTION("Mixed expressions"){
+        Peanut::Matrix<float, 5, 7, Peanut::Storage::Auto, 0, Peanut::Layout::ColMajor> col;
+        Peanut::Matrix<float, 5, 5> abt;
+        Peanut::Matrix<float, 5, 7> tt;
+        const Peanut::Matrix<float, 7, 5> bt = Peanut::T(b);
+        Peanut::EvalAll(Peanut::Assign(col, a - b), Peanut::Assign(tt, Peanut::T(bt)));
+        Peanut::EvalAll(Peanut::Assign(abt, a * Peanut::T(b)));
+        const Peanut::Matrix<float, 5, 5> expected = a * Peanut::T(b);
+        for (Peanut::Index i = 0; i < 5; i++) {
+            for (Peanut::Index j = 0; j < 5; j++) {
+                CHECK(col(i, j) == Catch::Approx(a(i, j) - b(i, j)));
+                CHECK(tt(i, j) == Catch::Approx(b(i, j)));
+                CHECK(abt(i, j) == Catch::Approx(expected(i, j)));
+            }
+        }
+    }
+    SECTION("Outputs read by expressions"){
+        // Element-wise expressions see values before any assignment
+        Peanut::EvalAll(Peanut::Assign(a, b), Peanut::Assign(b, a + b));
+        for (Peanut::Index i = 0; i < 5; i++) {
+            for (Peanut::Index j = 0; j < 7; j++) {
+                CHECK(a(i, j) == Catch::Approx(b0(i, j)));
+                CHECK(b(i, j) == Catch::Approx(a0(i, j) + b0(i, j)));
+            }
+        }
+
+        // Other expressions are evaluated first
+        Peanut::Matrix<float, 5, 5> c = Peanut::Block<0, 0, 5, 5>(a0);
+        Peanut::Matrix<float, 5, 5> d = Peanut::Block<0, 0, 5, 5>(b0);
+        const Peanut::Matrix<float, 5, 5> c0 = c, d0 = d;
+        Peanut::EvalAll(Peanut::Assign(c, Peanut::T(d)), Peanut::Assign(d, c * c));
+        const Peanut::Matrix<float, 5, 5> c0c0 = c0 * c0;
+        for (Peanut::Index i = 0; i < 5; i++) {
+            for (Peanut::Index j = 0; j < 5; j++) {
+                CHECK(c(i, j) == Catch::Approx(d0(j, i)));
+                CHECK(d(i, j) == Catch::Approx(c0c0(i, j)));
+            }
+        }
+    }
+}
+
 TEST_CASE("gaussian_elimination"){
     CHECK("TBD");
 }
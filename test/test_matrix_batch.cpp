@@ -0,0 +1,149 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+// Standard headers
+#include <array>
+
+// Peanut headers
+#include <Peanut.h>
+
+// Dependencies headers
+#include "catch_amalgamated.hpp"
+
+
+namespace {
+    template<Peanut::Index N>
+    std::array<Peanut::Matrix<float, 3, 3>, N> create_matrices(){
+        std::array<Peanut::Matrix<float, 3, 3>, N> mats;
+        for(Peanut::Index k=0;k<N;k++){
+            const float f = static_cast<float>(k);
+            mats[k] = Peanut::Matrix<float, 3, 3>{2.0f + f, 1.0f, 0.5f * f,
+                                                  0.0f, 3.0f, 1.0f,
+                                                  1.0f, f, 4.0f};
+        }
+        return mats;
+    }
+}
+
+TEST_CASE("MatrixBatch : gather and scatter"){
+    auto mats = create_matrices<5>();
+    auto batch = Peanut::MatrixBatch<float, 3, 3, 5>::gather(mats);
+    CHECK(batch(0, 0, 3) == Catch::Approx(5.0f));
+    CHECK(batch.lanes(2, 1)[4] == Catch::Approx(4.0f));
+    CHECK(batch.lanes(0, 1) + 5 == batch.lanes(0, 2));
+
+    auto m = batch.get(2);
+    CHECK(m(0, 2) == Catch::Approx(1.0f));
+
+    batch.set(1, Peanut::Matrix<float, 3, 3>::identity() * 2.0f);
+    std::array<Peanut::Matrix<float, 3, 3>, 5> out;
+    batch.scatter(out);
+    CHECK(out[1](0, 0) == Catch::Approx(2.0f));
+    CHECK(out[1](0, 1) == Catch::Approx(0.0f));
+    CHECK(out[4](2, 1) == Catch::Approx(4.0f));
+}
+
+TEST_CASE("MatrixBatch : operations"){
+    constexpr Peanut::Index N = 7;
+    auto mats = create_matrices<N>();
+    auto a = Peanut::MatrixBatch<float, 3, 3, N>::gather(mats);
+    auto b = Peanut::T(a);
+
+    auto sum = a + b * 2.0f;
+    auto diff = -(a - b) / 2.0f;
+    auto emult = a % b;
+    auto prod = a * b;
+    auto det = a.det();
+    auto inv = Peanut::Inverse(a);
+
+    for(Peanut::Index k=0;k<N;k++){
+        const auto &m = mats[k];
+        Peanut::Matrix<float, 3, 3> ref_sum = m + Peanut::T(m) * 2.0f;
+        Peanut::Matrix<float, 3, 3> ref_diff = -(m - Peanut::T(m)) / 2.0f;
+        Peanut::Matrix<float, 3, 3> ref_emult = m % Peanut::T(m);
+        Peanut::Matrix<float, 3, 3> ref_prod = m * Peanut::T(m);
+        Peanut::Matrix<float, 3, 3> ref_inv = Peanut::Inverse(m);
+        CHECK(det[k] == Catch::Approx(m.det()));
+        for(Peanut::Index r=0;r<3;r++){
+            for(Peanut::Index c=0;c<3;c++){
+                CHECK(sum(r, c, k) == Catch::Approx(ref_sum(r, c)));
+                CHECK(diff(r, c, k) == Catch::Approx(ref_diff(r, c)));
+                CHECK(emult(r, c, k) == Catch::Approx(ref_emult(r, c)));
+                CHECK(prod(r, c, k) == Catch::Approx(ref_prod(r, c)));
+                CHECK(inv(r, c, k) == Catch::Approx(ref_inv(r, c)));
+            }
+        }
+    }
+
+    auto ident = a * inv;
+    for(Peanut::Index k=0;k<N;k++){
+        CHECK(ident(0, 0, k) == Catch::Approx(1.0f));
+        CHECK(ident(1, 2, k) == Catch::Approx(0.0f).margin(1e-5));
+    }
+}
+
+TEST_CASE("MatrixBatch : 4x4 determinant and inverse"){
+    Peanut::MatrixBatch<double, 4, 4, 3> batch;
+    std::array<Peanut::Matrix<double, 4, 4>, 3> mats;
+    for(Peanut::Index k=0;k<3;k++){
+        const double d = static_cast<double>(k);
+        mats[k] = Peanut::Matrix<double, 4, 4>{4.0 + d, 1.0, 2.0, 0.0,
+                                               1.0, 3.0, 0.0, d,
+                                               0.0, 2.0, 5.0, 1.0,
+                                               1.0, 0.0, d, 6.0};
+    }
+    batch = Peanut::MatrixBatch<double, 4, 4, 3>::gather(mats);
+    auto det = batch.det();
+    auto inv = Peanut::Inverse(batch);
+    for(Peanut::Index k=0;k<3;k++){
+        CHECK(det[k] == Catch::Approx(mats[k].det()));
+        Peanut::Matrix<Peanut::Float, 4, 4> ref = Peanut::Inverse(mats[k]);
+        for(Peanut::Index r=0;r<4;r++){
+            for(Peanut::Index c=0;c<4;c++){
+                CHECK(inv(r, c, k) == Catch::Approx(ref(r, c)));
+            }
+        }
+    }
+}
+
+TEST_CASE("MatrixBatch : vector features"){
+    Peanut::MatrixBatch<int, 3, 1, 4> x, y;
+    for(Peanut::Index k=0;k<4;k++){
+        const int i = static_cast<int>(k);
+        x.set(k, Peanut::Matrix<int, 3, 1>{1, i, 2});
+        y.set(k, Peanut::Matrix<int, 3, 1>{i, 1, 3});
+    }
+    auto dot = x.dot(y);
+    auto cross = Peanut::MatrixBatch<int, 3, 1, 4>::cross(x, y);
+    for(Peanut::Index k=0;k<4;k++){
+        auto xm = x.get(k);
+        auto ym = y.get(k);
+        CHECK(dot[k] == xm.dot(ym));
+        auto ref = Peanut::Matrix<int, 3, 1>::cross(xm, ym);
+        CHECK(cross(0, 0, k) == ref[0]);
+        CHECK(cross(1, 0, k) == ref[1]);
+        CHECK(cross(2, 0, k) == ref[2]);
+    }
+}
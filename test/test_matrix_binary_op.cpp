@@ -23,6 +23,7 @@
 //
 
 // Standard headers
+#include <cmath>
 #include <type_traits>
 
 // Peanut headers
@@ -145,6 +146,91 @@ TEST_CASE("Test binary operation : Mat * Mat"){
         CHECK(mul_mat(1, 0) == Catch::Approx(55.0f));
         CHECK(mul_mat(1, 1) == Catch::Approx(62.7f));
     }
+    SECTION("Operand nesting"){
+        Peanut::Matrix<float, 2, 2> flt_22_mat1{1.0f, 2.0f, 3.0f, 4.0f};
+        Peanut::Matrix<float, 2, 2> flt_22_mat2{6.6f,7.7f,8.8f,9.9f};
+
+        // Leaves are referred, costly operands are evaluated
+        auto prod = flt_22_mat1 * -flt_22_mat2;
+        STATIC_CHECK(std::is_same_v<decltype(prod.x), const Peanut::Matrix<float, 2, 2> &>);
+        STATIC_CHECK(std::is_same_v<decltype(prod.y), const decltype(-flt_22_mat2)>);
+        CHECK(&prod.x == &flt_22_mat1);
+
+        Peanut::DynMatrix<float> dyn(2, 2, {6.6f, 7.7f, 8.8f, 9.9f});
+        auto dyn_prod = dyn * -dyn;
+        STATIC_CHECK(std::is_same_v<decltype(dyn_prod.y), Peanut::Impl::MatrixShared<decltype(-dyn)>>);
+
+        // Copies of the product (e.g., in a parent node) share the evaluated operand
+        auto dyn_prod_copied = dyn_prod;
+        CHECK(dyn_prod_copied.y.result == dyn_prod.y.result);
+        auto dyn_sum = dyn_prod + dyn;
+        Peanut::DynMatrix<float> dyn_val = dyn_sum;
+        CHECK(dyn_val(0, 0) == Catch::Approx(-(6.6f * 6.6f + 7.7f * 8.8f) + 6.6f));
+
+        // Expression operands are stored by value, so they do not dangle
+        auto expr = Peanut::T(flt_22_mat1 + flt_22_mat2) * Peanut::T(flt_22_mat1.row(0));
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T(flt_22_mat1 + flt_22_mat2).x),
+                                    const decltype(flt_22_mat1 + flt_22_mat2)>);
+        Peanut::Matrix<float, 2, 1> val = expr;
+        CHECK(val(0, 0) == Catch::Approx(7.6f + 2.0f * 11.8f));
+        CHECK(val(1, 0) == Catch::Approx(9.7f + 2.0f * 13.9f));
+    }
+}
+
+TEST_CASE("Test binary operation : Transposed product"){
+    Peanut::Matrix<float, 3, 2> a{1.0f, 2.0f,
+                                  3.0f, 4.0f,
+                                  5.0f, 6.0f};
+    Peanut::Matrix<float, 3, 2> b{0.5f, -1.0f,
+                                  2.0f, 1.5f,
+                                  -3.0f, 0.0f};
+    Peanut::Matrix<float, 2, 3> at = Peanut::T(a);
+    Peanut::Matrix<float, 2, 3> bt = Peanut::T(b);
+
+    // Transposed leaves are referred without a transposed copy
+    auto prod = Peanut::T(a) * b;
+    STATIC_CHECK(std::is_same_v<decltype(prod.x), const decltype(Peanut::T(a))>);
+    CHECK(&prod.x.x == &a);
+
+    auto check = [](const auto &val, const auto &expected){
+        CHECK(val.rows() == expected.rows());
+        CHECK(val.cols() == expected.cols());
+        for (Peanut::Index i = 0; i < expected.rows(); i++) {
+            for (Peanut::Index j = 0; j < expected.cols(); j++) {
+                CHECK(val(i, j) == Catch::Approx(expected(i, j)));
+            }
+        }
+    };
+
+    SECTION("T(A) * B"){
+        Peanut::Matrix<float, 2, 2> val = Peanut::T(a) * b;
+        Peanut::Matrix<float, 2, 2> expected = at * b;
+        check(val, expected);
+    }
+    SECTION("A * T(B)"){
+        Peanut::Matrix<float, 3, 3> val = a * Peanut::T(b);
+        Peanut::Matrix<float, 3, 3> expected = a * bt;
+        check(val, expected);
+        // Fused with element-wise operations
+        Peanut::Matrix<float, 3, 3> fused = a * Peanut::T(b) + expected;
+        Peanut::Matrix<float, 3, 3> doubled = expected * 2.0f;
+        check(fused, doubled);
+    }
+    SECTION("T(A) * T(B)"){
+        Peanut::Matrix<float, 2, 2> val = Peanut::T(a) * Peanut::T(bt);
+        Peanut::Matrix<float, 2, 2> expected = at * b;
+        check(val, expected);
+    }
+    SECTION("Column-major and dynamic operands"){
+        Peanut::Matrix<float, 2, 2, Peanut::Storage::Auto, 0, Peanut::Layout::ColMajor> col = Peanut::T(a) * b;
+        check(col, at * b);
+        Peanut::Matrix<float, 3, 2, Peanut::Storage::Auto, 0, Peanut::Layout::ColMajor> a_col = a;
+        Peanut::Matrix<float, 2, 2> val = Peanut::T(a_col) * b;
+        check(val, at * b);
+        Peanut::DynMatrix<float> dyn(3, 2, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+        Peanut::DynMatrix<float> dyn_val = dyn * Peanut::T(b);
+        check(dyn_val, a * bt);
+    }
 }
 
 TEST_CASE("Test binary operation : Mat * Mat * Mat"){
@@ -161,6 +247,299 @@ TEST_CASE("Test binary operation : Mat * Mat * Mat"){
     }
 }
 
+TEST_CASE("Test binary operation : Matrix chain"){
+    SECTION("Compile-time ordering"){
+        using Order = Peanut::Impl::MatrixChain<10, 30, 5, 60>;
+        STATIC_CHECK(Order::cost(0, 2) == 4500);
+        STATIC_CHECK(Order::split(0, 2) == 1);
+
+        using Order2 = Peanut::Impl::MatrixChain<30, 35, 15, 5, 10, 20, 25>;
+        STATIC_CHECK(Order2::cost(0, 5) == 15125);
+        STATIC_CHECK(Order2::split(0, 5) == 2);
+        STATIC_CHECK(Order2::split(0, 2) == 0);
+        STATIC_CHECK(Order2::split(3, 5) == 4);
+    }
+    SECTION("Rewriting (A * B) * v"){
+        Peanut::Matrix<float, 3, 3> a{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+        Peanut::Matrix<float, 3, 3> b{0.5f, -1.0f, 2.0f, 1.5f, 0.0f, 1.0f, -2.0f, 3.0f, 0.5f};
+        Peanut::Matrix<float, 3, 1> v{1.0f, -1.0f, 2.0f};
+
+        using Mat = Peanut::Matrix<float, 3, 3>;
+        using Vec = Peanut::Matrix<float, 3, 1>;
+        STATIC_CHECK(std::is_same_v<decltype(a * b * v),
+                                    Peanut::Impl::MatrixMult<Mat, Peanut::Impl::MatrixMult<Mat, Vec>>>);
+        // Same cost, left-to-right order is kept
+        STATIC_CHECK(std::is_same_v<decltype(a * b * a),
+                                    Peanut::Impl::MatrixMult<Peanut::Impl::MatrixMult<Mat, Mat>, Mat>>);
+
+        Peanut::Matrix<float, 3, 3> ab = a * b;
+        Peanut::Matrix<float, 3, 1> expected = ab * v;
+        Peanut::Matrix<float, 3, 1> result = a * b * v;
+        for (Peanut::Index i = 0; i < 3; i++) {
+            CHECK(result(i, 0) == Catch::Approx(expected(i, 0)));
+        }
+    }
+    SECTION("Chain()"){
+        Peanut::Matrix<float, 2, 4> a{1.0f, 0.0f, 0.0f, 0.0f,
+                                      0.0f, 1.0f, 0.0f, 0.0f};
+        Peanut::Matrix<float, 4, 4> b{1.0f, 2.0f, 0.0f, 1.0f,
+                                      0.0f, 1.0f, 3.0f, 2.0f,
+                                      4.0f, 0.0f, 1.0f, 1.0f,
+                                      2.0f, 1.0f, 0.0f, 3.0f};
+        Peanut::Matrix<float, 4, 1> v{1.0f, 2.0f, 3.0f, 4.0f};
+        Peanut::Matrix<float, 1, 3> w{1.0f, -1.0f, 0.5f};
+
+        // (a * (b * v)) * w
+        auto prod = Peanut::Chain(a, b, v, w);
+        using Mat24 = Peanut::Matrix<float, 2, 4>;
+        using Mat44 = Peanut::Matrix<float, 4, 4>;
+        using Mat41 = Peanut::Matrix<float, 4, 1>;
+        using Mat13 = Peanut::Matrix<float, 1, 3>;
+        STATIC_CHECK(std::is_same_v<decltype(prod),
+                     Peanut::Impl::MatrixMult<Peanut::Impl::MatrixMult<Mat24, Peanut::Impl::MatrixMult<Mat44, Mat41>>, Mat13>>);
+
+        Peanut::Matrix<float, 2, 3> result = prod;
+        // a * b * v = (9, 19)
+        CHECK(result(0, 0) == Catch::Approx(9.0f));
+        CHECK(result(0, 1) == Catch::Approx(-9.0f));
+        CHECK(result(0, 2) == Catch::Approx(4.5f));
+        CHECK(result(1, 0) == Catch::Approx(19.0f));
+        CHECK(result(1, 2) == Catch::Approx(9.5f));
+    }
+}
+
+TEST_CASE("Test binary operation : Fused product epilogue"){
+    Peanut::Matrix<float, 3, 2> a{1.0f, 2.0f,
+                                  3.0f, 4.0f,
+                                  5.0f, 6.0f};
+    Peanut::Matrix<float, 2, 3> b{0.5f, 1.0f, 1.5f,
+                                  2.0f, 2.5f, 3.0f};
+    Peanut::Matrix<float, 3, 3> c{1.0f, 0.0f, -1.0f,
+                                  2.0f, 0.5f, 0.0f,
+                                  -3.0f, 1.0f, 4.0f};
+    Peanut::Matrix<float, 3, 3> ab = a * b;
+
+    using Peanut::has_epilogue_v;
+    STATIC_CHECK(has_epilogue_v<decltype(a * b + c)>);
+    STATIC_CHECK(has_epilogue_v<decltype(2.0f * (a * b) - c)>);
+    STATIC_CHECK(has_epilogue_v<decltype(Peanut::Sqrt(a * b))>);
+    STATIC_CHECK(has_epilogue_v<decltype(-Peanut::Cast<int>(c + a * b))>);
+    STATIC_CHECK_FALSE(has_epilogue_v<decltype(a * b + a * b)>);
+    STATIC_CHECK_FALSE(has_epilogue_v<decltype(c + c)>);
+    STATIC_CHECK_FALSE(has_epilogue_v<decltype(Peanut::T((a + a) * b) + c)>);
+
+    SECTION("Bias"){
+        Peanut::Matrix<float, 3, 3> val = a * b + c;
+        Peanut::Matrix<float, 3, 3, Peanut::Storage::Auto, 0, Peanut::Layout::ColMajor> val_col = c + a * b;
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                CHECK(val(i, j) == Catch::Approx(ab(i, j) + c(i, j)));
+                CHECK(val_col(i, j) == Catch::Approx(ab(i, j) + c(i, j)));
+            }
+        }
+    }
+    SECTION("Scale and subtract"){
+        Peanut::Matrix<float, 3, 3> val = 2.0f * (a * b) - c;
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                CHECK(val(i, j) == Catch::Approx(2.0f * ab(i, j) - c(i, j)));
+            }
+        }
+    }
+    SECTION("Activation"){
+        Peanut::Matrix<float, 3, 3> val = Peanut::Sqrt(a * b);
+        Peanut::Matrix<int, 3, 3> cast = -Peanut::Cast<int>(c + a * b);
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                CHECK(val(i, j) == Catch::Approx(std::sqrt(ab(i, j))));
+                CHECK(cast(i, j) == -static_cast<int>(c(i, j) + ab(i, j)));
+            }
+        }
+    }
+    SECTION("DynMatrix"){
+        Peanut::DynMatrix<float> dyn_a(3, 2, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+        Peanut::DynMatrix<float> val = dyn_a * b + c;
+        CHECK(val.rows() == 3);
+        CHECK(val.cols() == 3);
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                CHECK(val(i, j) == Catch::Approx(ab(i, j) + c(i, j)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Test binary operation : Cost-based materialization"){
+    using Peanut::cost_v;
+    using Peanut::is_costly_v;
+
+    Peanut::Matrix<float, 4, 4> a4;
+    Peanut::Matrix<float, 40, 40> a, b;
+    for (Peanut::Index i = 0; i < 40; i++) {
+        for (Peanut::Index j = 0; j < 40; j++) {
+            a(i, j) = static_cast<float>((i + 2 * j) % 7) - 3.0f;
+            b(i, j) = static_cast<float>((3 * i + j) % 5) - 2.0f;
+        }
+    }
+    Peanut::Matrix<float, 40, 40> ab = a * b;
+    Peanut::Matrix<float, 40, 40> ba = b * a;
+
+    STATIC_CHECK(cost_v<decltype(a4)> == 0);
+    STATIC_CHECK(cost_v<decltype(a4 + a4)> == 1);
+    STATIC_CHECK(cost_v<decltype(-(a4 + a4))> == 2);
+    STATIC_CHECK(cost_v<decltype(a4 * a4)> == 8);
+    STATIC_CHECK(cost_v<decltype(a * b)> == 80);
+    STATIC_CHECK_FALSE(is_costly_v<decltype(a4 * a4)>);
+    STATIC_CHECK(is_costly_v<decltype(a * b)>);
+    STATIC_CHECK(is_costly_v<decltype(a4 + a4), Peanut::Dynamic>);
+
+    SECTION("Cheap operands are lazy"){
+        auto expr = a4 * a4 + a4 * a4;
+        STATIC_CHECK(std::is_same_v<decltype(expr.y), const decltype(a4 * a4)>);
+    }
+    SECTION("Costly products"){
+        // One of the products is fused, the other is evaluated
+        auto expr = a * b % (b * a);
+        STATIC_CHECK(std::is_same_v<decltype(expr.x), const decltype(a * b)>);
+        STATIC_CHECK(std::is_same_v<decltype(expr.y), const Peanut::Impl::MatrixShared<decltype(b * a)>>);
+        STATIC_CHECK(Peanut::has_epilogue_v<decltype(expr)>);
+
+        Peanut::Matrix<float, 40, 40> val = expr;
+        Peanut::Matrix<float, 40, 40> val_t = Peanut::T(a * b);
+        for (Peanut::Index i = 0; i < 40; i++) {
+            for (Peanut::Index j = 0; j < 40; j++) {
+                CHECK(val(i, j) == Catch::Approx(ab(i, j) * ba(i, j)));
+                CHECK(val_t(i, j) == Catch::Approx(ab(j, i)));
+            }
+        }
+    }
+    SECTION("Transpose of costly product"){
+        auto expr = Peanut::T((a + b) * b);
+        STATIC_CHECK(std::is_same_v<decltype(expr.x), const Peanut::Impl::MatrixShared<decltype((a + b) * b)>>);
+
+        Peanut::Matrix<float, 40, 40> sum = a + b;
+        Peanut::Matrix<float, 40, 40> expected = sum * b;
+        Peanut::Matrix<float, 40, 40> val = expr;
+        for (Peanut::Index i = 0; i < 40; i++) {
+            for (Peanut::Index j = 0; j < 40; j++) {
+                CHECK(val(i, j) == Catch::Approx(expected(j, i)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Test binary operation : Algebraic simplification"){
+    using Peanut::Impl::MatrixMult;
+    using Peanut::Impl::MatrixMultScalar;
+    using Peanut::Impl::MatrixSum;
+    using Peanut::Impl::MatrixSubtract;
+    using Peanut::Impl::MatrixTranspose;
+    using Peanut::Impl::MatrixInverse;
+    using Mat = Peanut::Matrix<float, 3, 3>;
+    using IMat = Peanut::Matrix<int, 3, 3>;
+
+    Mat a{1.0f, 2.0f, 0.0f,
+          -1.0f, 3.0f, 1.0f,
+          2.0f, 0.0f, 4.0f};
+    Mat b{0.5f, 1.0f, -2.0f,
+          3.0f, 0.0f, 1.0f,
+          1.0f, 2.0f, 0.5f};
+    IMat ia{1, 2, 3,
+            4, 5, 6,
+            7, 8, 10};
+
+    auto check = [](const auto &val, const auto &expected){
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                CHECK(val(i, j) == Catch::Approx(expected(i, j)));
+            }
+        }
+    };
+
+    SECTION("Scalar folding"){
+        STATIC_CHECK(std::is_same_v<decltype((ia * 2) * 3), MatrixMultScalar<IMat, int>>);
+        STATIC_CHECK(std::is_same_v<decltype(2 * (3 * ia)), MatrixMultScalar<IMat, int>>);
+        STATIC_CHECK(std::is_same_v<decltype(a * 4.0f * 0.5f), MatrixMultScalar<Mat, float>>);
+
+        CHECK(((ia * 2) * 3).y == 6);
+        CHECK((2 * (3 * ia)).y == 6);
+        IMat folded = (ia * 2) * 3;
+        CHECK(folded(2, 2) == 60);
+        Mat scaled = (a * 4.0f) / 2.0f * 0.5f;
+        check(scaled, a);
+    }
+    SECTION("Division by scalar"){
+        STATIC_CHECK(std::is_same_v<decltype(a / 2.0f), Peanut::Impl::MatrixDivScalar<Mat, float>>);
+        CHECK(Peanut::Impl::is_exact_reciprocal(2.0f));
+        CHECK(Peanut::Impl::is_exact_reciprocal(-0.25f));
+        CHECK_FALSE(Peanut::Impl::is_exact_reciprocal(3.0f));
+        CHECK_FALSE(Peanut::Impl::is_exact_reciprocal(0.1f));
+        CHECK((a / 2.0f).exact);
+        CHECK((ia / 4).inv == 0.25f);
+        CHECK_FALSE((a / 3.0f).exact);
+
+        // Exact reciprocal gives the same result as the division
+        Mat halved = a / 2.0f;
+        Peanut::Matrix<Peanut::Float, 3, 3> quartered = ia / 4;
+        // Other divisors are not rounded to a reciprocal
+        Mat thirds = a / 3.0f;
+        Peanut::Matrix<Peanut::Float, 3, 3> ithirds = ia / 3;
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                CHECK(halved(i, j) == a(i, j) / 2.0f);
+                CHECK(quartered(i, j) == static_cast<Peanut::Float>(ia(i, j)) / 4.0f);
+                CHECK(thirds(i, j) == a(i, j) / 3.0f);
+                CHECK(ithirds(i, j) == static_cast<Peanut::Float>(ia(i, j)) / 3.0f);
+            }
+        }
+        CHECK(ithirds(2, 0) == 7.0f / 3.0f);
+        // Nested in other expressions as well
+        Mat nested = a / 2.0f + a / 3.0f;
+        CHECK(nested(2, 2) == a(2, 2) / 2.0f + a(2, 2) / 3.0f);
+        CHECK_THROWS(a / 0.0f);
+    }
+    SECTION("Negation"){
+        STATIC_CHECK(std::is_same_v<decltype(-a * -b), MatrixMult<Mat, Mat>>);
+        STATIC_CHECK(std::is_same_v<decltype(-(-a)), const Mat &>);
+        Mat val = -a * -b;
+        check(val, a * b);
+    }
+    SECTION("Transpose of product"){
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T(a * b)), MatrixMult<MatrixTranspose<Mat>, MatrixTranspose<Mat>>>);
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T(Peanut::T(a) * b)), MatrixMult<MatrixTranspose<Mat>, Mat>>);
+        // Non-leaf operands are kept, as rewriting would not be cheaper
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T((a + b) * b)), MatrixTranspose<MatrixMult<MatrixSum<Mat, Mat>, Mat>>>);
+
+        Mat ab = a * b;
+        Mat val = Peanut::T(a * b);
+        Mat val2 = Peanut::T(Peanut::T(a) * b);
+        Mat atb = Peanut::T(a) * b;
+        check(val, Peanut::T(ab));
+        check(val2, Peanut::T(atb));
+    }
+    SECTION("Transpose of sum and difference"){
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T(Peanut::T(a) + b)), MatrixSum<Mat, MatrixTranspose<Mat>>>);
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T(a - Peanut::T(b))), MatrixSubtract<MatrixTranspose<Mat>, Mat>>);
+        // Without a transpose to cancel, it is kept
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T(a + b)), MatrixTranspose<MatrixSum<Mat, Mat>>>);
+
+        Mat val = Peanut::T(Peanut::T(a) + b);
+        Mat sum = Peanut::T(a) + b;
+        check(val, Peanut::T(sum));
+        Mat val2 = Peanut::T(a - Peanut::T(b));
+        Mat diff = a - Peanut::T(b);
+        check(val2, Peanut::T(diff));
+    }
+    SECTION("Inverse of transpose"){
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::Inverse(Peanut::T(a))), MatrixTranspose<MatrixInverse<Mat>>>);
+        STATIC_CHECK(std::is_same_v<decltype(Peanut::T(Peanut::Inverse(Peanut::T(a)))), const MatrixInverse<Mat>>);
+
+        Mat at = Peanut::T(a);
+        Mat val = Peanut::Inverse(Peanut::T(a));
+        check(val, Peanut::Inverse(at));
+    }
+}
+
 TEST_CASE("Test binary operation : Element-wise multiply"){
     SECTION("float matrix"){
         Peanut::Matrix<float, 2, 2> flt_22_mat1{1.0f, 2.0f, 3.0f, 4.0f};
@@ -225,3 +604,84 @@ TEST_CASE("Test binary operation : Random matrix arithmetic"){
 }
 
 
+
+TEST_CASE("Test binary operation : Linear access"){
+    using Mat = Peanut::Matrix<float, 3, 5>;
+    using ColMat = Peanut::ColMajorMatrix<float, 3, 5>;
+    using PadMat = Peanut::PaddedMatrix<float, 3, 5>;
+
+    Mat a{1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+          6.0f, 7.0f, 8.0f, 9.0f, 10.0f,
+          11.0f, 12.0f, 13.0f, 14.0f, 15.0f};
+    Mat b = a * 2.0f;
+    ColMat ca = a;
+    PadMat pa = a;
+
+    STATIC_CHECK(Peanut::is_linear_v<decltype(a + b - a * 2.0f)>);
+    STATIC_CHECK(Peanut::is_linear_v<decltype(Peanut::Sqrt(a % b) / 2.0f)>);
+    STATIC_CHECK(Peanut::is_linear_v<decltype(-Peanut::Cast<int>(ca + ca))>);
+    STATIC_CHECK(Peanut::is_linear_v<Peanut::DynMatrix<float>>);
+    STATIC_CHECK_FALSE(Peanut::is_linear_v<PadMat>);
+    STATIC_CHECK_FALSE(Peanut::is_linear_v<decltype(a + ca)>);
+    STATIC_CHECK_FALSE(Peanut::is_linear_v<decltype(a + pa)>);
+    STATIC_CHECK_FALSE(Peanut::is_linear_v<decltype(Peanut::T(a) + Peanut::T(b))>);
+    STATIC_CHECK_FALSE(Peanut::is_linear_v<decltype(a * Peanut::T(b))>);
+
+    // Flat loop
+    Mat linear = a + b - a * 3.0f + EDiv(b, a);
+    // Element-wise loop for mixed layouts and padded rows
+    Mat mixed = a + ca - ca * 2.0f + EDiv(b, a);
+    PadMat padded = pa + b - a * 3.0f + EDiv(b, pa);
+    ColMat col = ca + ca - ca * 2.0f + EDiv(ca, ca) * 2.0f;
+    Peanut::DynMatrix<float> dyn = a + b - a * 3.0f + EDiv(b, a);
+    for(Peanut::Index r=0;r<3;r++){
+        for(Peanut::Index c=0;c<5;c++){
+            CHECK(linear(r, c) == Catch::Approx(2.0f));
+            CHECK(mixed(r, c) == Catch::Approx(2.0f));
+            CHECK(padded(r, c) == Catch::Approx(2.0f));
+            CHECK(col(r, c) == Catch::Approx(2.0f));
+            CHECK(dyn(r, c) == Catch::Approx(2.0f));
+        }
+    }
+}
+
+TEST_CASE("Test binary operation : SIMD packet evaluation"){
+    // 7x5 is not a multiple of any packet size, so the scalar tail is tested as well
+    Peanut::Matrix<float, 7, 5> a, b;
+    Peanut::Matrix<int, 7, 5> ia, ib;
+    for(Peanut::Index r=0;r<7;r++){
+        for(Peanut::Index c=0;c<5;c++){
+            a(r, c) = static_cast<float>(r * 5 + c + 1);
+            b(r, c) = static_cast<float>(c + 2);
+            ia(r, c) = static_cast<int>(r * 5 + c) - 10;
+            ib(r, c) = static_cast<int>(c) + 1;
+        }
+    }
+
+    using Expr = decltype(Peanut::Sqrt(a % b - a) / 2.0f + (-a) * 3.0f);
+    STATIC_CHECK(Peanut::is_vectorizable_v<Expr> == Peanut::Impl::has_packet_v<float>);
+    STATIC_CHECK(Peanut::is_vectorizable_v<decltype(ia + ib)> == Peanut::Impl::has_packet_v<int>);
+    STATIC_CHECK_FALSE(Peanut::is_vectorizable_v<decltype(EDiv(ia, ib))>);
+    STATIC_CHECK_FALSE(Peanut::is_vectorizable_v<decltype(Peanut::T(a) + Peanut::T(b))>);
+
+    Peanut::Matrix<float, 7, 5> f = Peanut::Sqrt(a % b - a) / 2.0f + (-a) * 3.0f;
+    Peanut::Matrix<float, 7, 5> fdiv = EDiv(a, b) - b;
+    Peanut::Matrix<int, 7, 5> i = (ia + ib) % ib - (-ia) * 2;
+    Peanut::Matrix<float, 7, 5> cast = Peanut::Cast<float>(ia) * 0.5f + a;
+    Peanut::Matrix<int, 7, 5> icast = Peanut::Cast<int>(a * 1.5f);
+    Peanut::Matrix<Peanut::Float, 7, 5> idiv = ia / 4;
+    Peanut::DynMatrix<float> dyn = a + b * 2.0f;
+    for(Peanut::Index r=0;r<7;r++){
+        for(Peanut::Index c=0;c<5;c++){
+            const float x = a(r, c), y = b(r, c);
+            const int ix = ia(r, c), iy = ib(r, c);
+            CHECK(f(r, c) == Catch::Approx(std::sqrt(x * y - x) / 2.0f - x * 3.0f));
+            CHECK(fdiv(r, c) == Catch::Approx(x / y - y));
+            CHECK(i(r, c) == (ix + iy) * iy + ix * 2);
+            CHECK(cast(r, c) == Catch::Approx(static_cast<float>(ix) * 0.5f + x));
+            CHECK(icast(r, c) == static_cast<int>(x * 1.5f));
+            CHECK(idiv(r, c) == Catch::Approx(static_cast<float>(ix) / 4.0f));
+            CHECK(dyn(r, c) == Catch::Approx(x + y * 2.0f));
+        }
+    }
+}
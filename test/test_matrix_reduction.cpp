@@ -0,0 +1,248 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Peanut headers
+#include <Peanut.h>
+
+// Dependencies headers
+#include "catch_amalgamated.hpp"
+
+
+TEST_CASE("Reduction : full reductions"){
+    Peanut::Matrix<float, 3, 4> a{1.0f, -2.0f, 3.0f, 0.5f,
+                                  -4.0f, 5.0f, 6.0f, -1.5f,
+                                  7.0f, 8.0f, -9.0f, 2.0f};
+    Peanut::Matrix<float, 3, 4> b{0.5f, 1.0f, -1.0f, 2.0f,
+                                  3.0f, -2.5f, 0.0f, 1.0f,
+                                  -1.0f, 4.0f, 2.0f, -3.0f};
+
+    float sum = 0.0f, prod = 1.0f, sq = 0.0f, l1 = 0.0f, linf = 0.0f;
+    float lo = a(0, 0), hi = a(0, 0), diff_sq = 0.0f;
+    for (Peanut::Index i = 0; i < 3; i++) {
+        for (Peanut::Index j = 0; j < 4; j++) {
+            sum += a(i, j);
+            prod *= a(i, j);
+            sq += a(i, j) * a(i, j);
+            l1 += std::abs(a(i, j));
+            linf = std::max(linf, std::abs(a(i, j)));
+            lo = std::min(lo, a(i, j));
+            hi = std::max(hi, a(i, j));
+            diff_sq += (a(i, j) - b(i, j)) * (a(i, j) - b(i, j));
+        }
+    }
+
+    CHECK(Peanut::Sum(a) == Catch::Approx(sum));
+    CHECK(Peanut::Prod(a) == Catch::Approx(prod));
+    CHECK(Peanut::Mean(a) == Catch::Approx(sum / 12.0f));
+    CHECK(Peanut::MinCoeff(a) == Catch::Approx(lo));
+    CHECK(Peanut::MaxCoeff(a) == Catch::Approx(hi));
+    CHECK(Peanut::SquaredNorm(a) == Catch::Approx(sq));
+    CHECK(Peanut::Norm(a) == Catch::Approx(std::sqrt(sq)));
+    CHECK(Peanut::NormL1(a) == Catch::Approx(l1));
+    CHECK(Peanut::NormLinf(a) == Catch::Approx(linf));
+
+    SECTION("Expression"){
+        CHECK(Peanut::Sum((a - b) % (a - b)) == Catch::Approx(diff_sq));
+        CHECK(Peanut::SquaredNorm(a - b) == Catch::Approx(diff_sq));
+        // Non-linear expression
+        CHECK(Peanut::Sum(Peanut::T(a)) == Catch::Approx(sum));
+        CHECK(Peanut::MaxCoeff(-Peanut::T(a)) == Catch::Approx(-lo));
+        CHECK(Peanut::NormL1(Peanut::Block<1, 1, 2, 2>(a)) == Catch::Approx(5.0f + 6.0f + 8.0f + 9.0f));
+    }
+    SECTION("Product"){
+        Peanut::Matrix<float, 3, 3> ab = a * Peanut::T(b);
+        Peanut::Matrix<float, 3, 3> ones{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+        float ab_sum = 0.0f;
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                ab_sum += ab(i, j) + 1.0f;
+            }
+        }
+        CHECK(Peanut::Sum(a * Peanut::T(b) + ones) == Catch::Approx(ab_sum));
+        CHECK(Peanut::Trace(a * Peanut::T(b)) == Catch::Approx(ab(0, 0) + ab(1, 1) + ab(2, 2)));
+    }
+    SECTION("Integer"){
+        Peanut::Matrix<int, 2, 9> m;
+        int sum_int = 0, sq_int = 0;
+        for (Peanut::Index j = 0; j < 9; j++) {
+            m(0, j) = static_cast<int>(j) - 4;
+            m(1, j) = 2 * static_cast<int>(j) - 7;
+            sum_int += m(0, j) + m(1, j);
+            sq_int += m(0, j) * m(0, j) + m(1, j) * m(1, j);
+        }
+        CHECK(Peanut::Sum(m) == sum_int);
+        CHECK(Peanut::SquaredNorm(m) == sq_int);
+        CHECK(Peanut::MinCoeff(m) == -7);
+        CHECK(Peanut::MaxCoeff(m) == 9);
+        CHECK(Peanut::NormLinf(m) == 9);
+        CHECK(Peanut::NormL1(m - m) == 0);
+
+        Peanut::Matrix<unsigned int, 2, 2> u{1u, 2u, 3u, 4u};
+        CHECK(Peanut::NormL1(u) == 10u);
+        CHECK(Peanut::NormLinf(u) == 4u);
+    }
+    SECTION("Dynamic"){
+        Peanut::DynMatrix<float> dyn(3, 4);
+        dyn = a;
+        CHECK(Peanut::Sum(dyn + a) == Catch::Approx(2.0f * sum));
+        CHECK(Peanut::NormLinf(dyn) == Catch::Approx(linf));
+
+        Peanut::DynMatrix<float> empty;
+        CHECK(Peanut::Sum(empty) == 0.0f);
+        CHECK(Peanut::Prod(empty) == 1.0f);
+        CHECK(Peanut::SquaredNorm(empty) == 0.0f);
+        CHECK(Peanut::NormL1(empty) == 0.0f);
+        CHECK(Peanut::NormLinf(empty) == 0.0f);
+        CHECK_THROWS_AS(Peanut::MinCoeff(empty), std::invalid_argument);
+        CHECK_THROWS_AS(Peanut::MaxCoeff(empty), std::invalid_argument);
+        CHECK_THROWS_AS(Peanut::Trace(dyn), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Reduction : large matrix"){
+    // Multiple packets with remaining tail
+    Peanut::Matrix<double, 13, 11> a;
+    double sum = 0.0, sq = 0.0;
+    for (Peanut::Index i = 0; i < 13; i++) {
+        for (Peanut::Index j = 0; j < 11; j++) {
+            a(i, j) = static_cast<double>((3 * i + 5 * j) % 17) - 8.0;
+            sum += a(i, j);
+            sq += a(i, j) * a(i, j);
+        }
+    }
+    CHECK(Peanut::Sum(a) == Catch::Approx(sum));
+    CHECK(Peanut::SquaredNorm(a) == Catch::Approx(sq));
+    CHECK(Peanut::Sum(2.0 * a) == Catch::Approx(2.0 * sum));
+    CHECK(Peanut::MinCoeff(a) == Catch::Approx(-8.0));
+    CHECK(Peanut::MaxCoeff(a) == Catch::Approx(8.0));
+    CHECK(Peanut::Trace(Peanut::Block<0, 0, 11, 11>(a)) == Catch::Approx(
+        [&](){ double t = 0.0; for (Peanut::Index i = 0; i < 11; i++) { t += a(i, i); } return t; }()));
+}
+
+TEST_CASE("Reduction : partial reductions"){
+    Peanut::Matrix<float, 3, 10> a;
+    Peanut::Matrix<float, 3, 10, Peanut::Storage::Auto, 0, Peanut::Layout::ColMajor> a_col;
+    for (Peanut::Index i = 0; i < 3; i++) {
+        for (Peanut::Index j = 0; j < 10; j++) {
+            a(i, j) = static_cast<float>((2 * i + 3 * j) % 7) - 3.0f;
+            a_col(i, j) = a(i, j);
+        }
+    }
+
+    auto row_ref = [&](Peanut::Index i, auto map, auto fold) {
+        float ret = map(a(i, 0));
+        for (Peanut::Index j = 1; j < 10; j++) {
+            ret = fold(ret, map(a(i, j)));
+        }
+        return ret;
+    };
+    auto col_ref = [&](Peanut::Index j, auto map, auto fold) {
+        float ret = map(a(0, j));
+        for (Peanut::Index i = 1; i < 3; i++) {
+            ret = fold(ret, map(a(i, j)));
+        }
+        return ret;
+    };
+    auto id = [](float x) { return x; };
+    auto sq = [](float x) { return x * x; };
+    auto plus = [](float x, float y) { return x + y; };
+    auto mn = [](float x, float y) { return std::min(x, y); };
+    auto mx = [](float x, float y) { return std::max(x, y); };
+
+    SECTION("Rowwise"){
+        STATIC_CHECK(decltype(Peanut::RowwiseSum(a))::Row == 3);
+        STATIC_CHECK(decltype(Peanut::RowwiseSum(a))::Col == 1);
+        Peanut::Matrix<float, 3, 1> sum = Peanut::RowwiseSum(a);
+        Peanut::Matrix<float, 3, 1> sum_col = Peanut::RowwiseSum(a_col);
+        Peanut::Matrix<float, 3, 1> mean = Peanut::RowwiseMean(a);
+        Peanut::Matrix<float, 3, 1> lo = Peanut::RowwiseMin(a_col);
+        Peanut::Matrix<float, 3, 1> hi = Peanut::RowwiseMax(a);
+        Peanut::Matrix<float, 3, 1> norm = Peanut::RowwiseNorm(a_col);
+        for (Peanut::Index i = 0; i < 3; i++) {
+            CHECK(sum(i, 0) == Catch::Approx(row_ref(i, id, plus)));
+            CHECK(sum_col(i, 0) == Catch::Approx(row_ref(i, id, plus)));
+            CHECK(mean(i, 0) == Catch::Approx(row_ref(i, id, plus) / 10.0f));
+            CHECK(lo(i, 0) == Catch::Approx(row_ref(i, id, mn)));
+            CHECK(hi(i, 0) == Catch::Approx(row_ref(i, id, mx)));
+            CHECK(norm(i, 0) == Catch::Approx(std::sqrt(row_ref(i, sq, plus))));
+        }
+    }
+    SECTION("Colwise"){
+        STATIC_CHECK(decltype(Peanut::ColwiseSum(a))::Row == 1);
+        STATIC_CHECK(decltype(Peanut::ColwiseSum(a))::Col == 10);
+        Peanut::Matrix<float, 1, 10> sum = Peanut::ColwiseSum(a);
+        Peanut::Matrix<float, 1, 10> sum_col = Peanut::ColwiseSum(a_col);
+        Peanut::Matrix<float, 1, 10> mean = Peanut::ColwiseMean(a_col);
+        Peanut::Matrix<float, 1, 10> lo = Peanut::ColwiseMin(a);
+        Peanut::Matrix<float, 1, 10> hi = Peanut::ColwiseMax(a);
+        Peanut::Matrix<float, 1, 10> sq_norm = Peanut::ColwiseSquaredNorm(a);
+        Peanut::Matrix<float, 1, 10> norm = Peanut::ColwiseNorm(a);
+        for (Peanut::Index j = 0; j < 10; j++) {
+            CHECK(sum(0, j) == Catch::Approx(col_ref(j, id, plus)));
+            CHECK(sum_col(0, j) == Catch::Approx(col_ref(j, id, plus)));
+            CHECK(mean(0, j) == Catch::Approx(col_ref(j, id, plus) / 3.0f));
+            CHECK(lo(0, j) == Catch::Approx(col_ref(j, id, mn)));
+            CHECK(hi(0, j) == Catch::Approx(col_ref(j, id, mx)));
+            CHECK(sq_norm(0, j) == Catch::Approx(col_ref(j, sq, plus)));
+            CHECK(norm(0, j) == Catch::Approx(std::sqrt(col_ref(j, sq, plus))));
+        }
+    }
+    SECTION("Composition"){
+        // Centering each column, and reductions of expressions
+        Peanut::Matrix<float, 1, 10> mean = Peanut::ColwiseMean(a);
+        Peanut::Matrix<float, 1, 10> centered_sum = Peanut::ColwiseSum(a - a) + 2.0f * Peanut::ColwiseSum(a);
+        Peanut::Matrix<float, 10, 1> t_sum = Peanut::RowwiseSum(Peanut::T(a));
+        for (Peanut::Index j = 0; j < 10; j++) {
+            CHECK(centered_sum(0, j) == Catch::Approx(2.0f * col_ref(j, id, plus)));
+            CHECK(t_sum(j, 0) == Catch::Approx(col_ref(j, id, plus)));
+        }
+        CHECK(Peanut::Sum(Peanut::RowwiseSum(a)) == Catch::Approx(Peanut::Sum(a)));
+        CHECK(Peanut::MaxCoeff(Peanut::ColwiseMax(a)) == Catch::Approx(Peanut::MaxCoeff(a)));
+        CHECK(Peanut::Sum(mean) == Catch::Approx(Peanut::Sum(a) / 3.0f));
+    }
+    SECTION("Dynamic"){
+        Peanut::DynMatrix<int> dyn(2, 9);
+        for (Peanut::Index j = 0; j < 9; j++) {
+            dyn(0, j) = static_cast<int>(j);
+            dyn(1, j) = 10 - static_cast<int>(j);
+        }
+        Peanut::DynMatrix<int> sum = Peanut::ColwiseSum(dyn);
+        Peanut::DynMatrix<int> hi = Peanut::RowwiseMax(dyn);
+        CHECK(sum.rows() == 1);
+        CHECK(sum.cols() == 9);
+        for (Peanut::Index j = 0; j < 9; j++) {
+            CHECK(sum(0, j) == 10);
+        }
+        CHECK(hi(0, 0) == 8);
+        CHECK(hi(1, 0) == 10);
+        CHECK_THROWS_AS(Peanut::ColwiseSum(Peanut::DynMatrix<int>()), std::invalid_argument);
+    }
+}
@@ -754,3 +754,42 @@ TEST_CASE("Test unary operation : Inverse"){
     }
 }
 
+
+TEST_CASE("Test unary operation : Shared"){
+    Peanut::Matrix<float, 3, 3> mat{1.0f, 2.0f, 0.0f,
+                                    -1.0f, 3.0f, 1.0f,
+                                    2.0f, 0.0f, 4.0f};
+    Peanut::Matrix<float, 3, 3> sq = mat * mat;
+
+    auto shared = Peanut::Shared(mat * mat);
+    STATIC_CHECK(Peanut::is_leaf_v<decltype(shared)>);
+
+    SECTION("Result is shared, not evaluated again"){
+        auto expr = mat + mat - shared * (mat + mat - shared);
+        STATIC_CHECK(std::is_same_v<decltype(expr.y.x), const decltype(shared)>);
+        CHECK(expr.y.x.result == shared.result);
+        CHECK(Peanut::Shared(shared).result == shared.result);
+
+        Peanut::Matrix<float, 3, 3> val = expr;
+        Peanut::Matrix<float, 3, 3> expected = mat + mat - sq * (mat + mat - sq);
+        for (Peanut::Index i = 0; i < 3; i++) {
+            for (Peanut::Index j = 0; j < 3; j++) {
+                CHECK(val(i, j) == Catch::Approx(expected(i, j)));
+            }
+        }
+    }
+    SECTION("Evaluated at construction"){
+        Peanut::Matrix<float, 3, 3> copy = mat;
+        auto s = Peanut::Shared(copy * copy);
+        copy = Peanut::Matrix<float, 3, 3>::zeros();
+        Peanut::Matrix<float, 3, 3> val = s;
+        CHECK(val(0, 0) == Catch::Approx(sq(0, 0)));
+        CHECK(val(2, 2) == Catch::Approx(sq(2, 2)));
+
+        // Assignment into an operand of the shared expression
+        copy = mat;
+        auto s2 = Peanut::Shared(copy * copy);
+        copy = s2 + s2;
+        CHECK(copy(1, 2) == Catch::Approx(2.0f * sq(1, 2)));
+    }
+}
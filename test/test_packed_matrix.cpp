@@ -0,0 +1,208 @@
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2022-2024 Jino Park
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+// Standard headers
+
+// Peanut headers
+#include <Peanut.h>
+
+// Dependencies headers
+#include "catch_amalgamated.hpp"
+
+
+TEST_CASE("Packed matrix : TriangularMatrix"){
+    Peanut::UpperTriangularMatrix<int, 3> u(1,2,3,
+                                              4,5,
+                                                6);
+    Peanut::LowerTriangularMatrix<int, 3> l(1,
+                                            2,3,
+                                            4,5,6);
+    STATIC_CHECK(sizeof(u.m_data) == 6*sizeof(int));
+
+    SECTION("Element access"){
+        CHECK(u(0, 2) == 3);
+        CHECK(u(1, 1) == 4);
+        CHECK(u(2, 0) == 0);
+        CHECK(l(2, 1) == 5);
+        CHECK(l(0, 2) == 0);
+
+        u.at(1, 2) = 10;
+        CHECK(u(1, 2) == 10);
+        CHECK(u.m_data[4] == 10);
+    }
+    SECTION("Evaluation"){
+        Peanut::Matrix<int, 3, 3> dense = u;
+        CHECK(dense(0, 1) == 2);
+        CHECK(dense(1, 0) == 0);
+        CHECK(dense(2, 2) == 6);
+
+        Peanut::ColMajorMatrix<int, 3, 3> cm = l;
+        CHECK(cm(2, 0) == 4);
+        CHECK(cm(0, 1) == 0);
+
+        Peanut::Matrix<int, 3, 3> full{9,9,9,
+                                       9,9,9,
+                                       9,9,9};
+        Peanut::LowerTriangularMatrix<int, 3> from_dense = full + dense;
+        CHECK(from_dense(1, 0) == 9);
+        CHECK(from_dense(2, 2) == 15);
+        CHECK(from_dense(0, 2) == 0);
+
+        auto ident = Peanut::UpperTriangularMatrix<float, 4>::identity();
+        CHECK(ident(3, 3) == Catch::Approx(1.0f));
+        CHECK(ident(1, 2) == Catch::Approx(0.0f));
+    }
+    SECTION("Product"){
+        Peanut::Matrix<int, 3, 3> du = u;
+        Peanut::Matrix<int, 3, 3> dl = l;
+        Peanut::Matrix<int, 3, 2> b{1,2,
+                                    3,4,
+                                    5,6};
+
+        Peanut::Matrix<int, 3, 3> ul = u * l;
+        Peanut::Matrix<int, 3, 3> ul_ref = du * dl;
+        Peanut::Matrix<int, 3, 2> ub = u * b;
+        Peanut::Matrix<int, 3, 2> ub_ref = du * b;
+        Peanut::Matrix<int, 2, 3> tbl = Peanut::T(b) * l;
+        Peanut::Matrix<int, 2, 3> tbl_ref = Peanut::T(b) * dl;
+        Peanut::ColMajorMatrix<int, 3, 3> lu = l * u;
+        Peanut::Matrix<int, 3, 3> lu_ref = dl * du;
+        for(Peanut::Index r=0;r<3;r++){
+            for(Peanut::Index c=0;c<3;c++){
+                CHECK(ul(r, c) == ul_ref(r, c));
+                CHECK(lu(r, c) == lu_ref(r, c));
+                CHECK((u * l)(r, c) == ul_ref(r, c));
+            }
+            for(Peanut::Index c=0;c<2;c++){
+                CHECK(ub(r, c) == ub_ref(r, c));
+                CHECK(tbl(c, r) == tbl_ref(c, r));
+            }
+        }
+
+        Peanut::UpperTriangularMatrix<int, 3> uu = u * u;
+        CHECK(uu(0, 0) == 1);
+        CHECK(uu(0, 2) == 1*3 + 2*5 + 3*6);
+        CHECK(uu(2, 2) == 36);
+    }
+}
+
+TEST_CASE("Packed matrix : SymmetricMatrix"){
+    Peanut::SymmetricMatrix<float, 3> s(1.0f,
+                                        2.0f, 3.0f,
+                                        4.0f, 5.0f, 6.0f);
+    STATIC_CHECK(sizeof(s.m_data) == 6*sizeof(float));
+
+    SECTION("Element access"){
+        CHECK(s(0, 2) == Catch::Approx(4.0f));
+        CHECK(s(2, 0) == Catch::Approx(4.0f));
+        s(1, 2) = 7.0f;
+        CHECK(s(2, 1) == Catch::Approx(7.0f));
+    }
+    SECTION("Evaluation"){
+        Peanut::Matrix<float, 3, 3> dense = s;
+        for(Peanut::Index r=0;r<3;r++){
+            for(Peanut::Index c=0;c<3;c++){
+                CHECK(dense(r, c) == Catch::Approx(s(r, c)));
+                CHECK(dense(r, c) == Catch::Approx(dense(c, r)));
+            }
+        }
+        Peanut::DynMatrix<float> dyn = s;
+        CHECK(dyn.rows() == 3);
+        CHECK(dyn(1, 2) == Catch::Approx(5.0f));
+    }
+    SECTION("Gram matrix"){
+        Peanut::Matrix<float, 4, 3> a{1.0f, 2.0f, 3.0f,
+                                      4.0f, 5.0f, 6.0f,
+                                      7.0f, 8.0f, 9.0f,
+                                      1.0f, 0.0f, 1.0f};
+        Peanut::SymmetricMatrix<float, 3> gram = Peanut::T(a) * a;
+        Peanut::Matrix<float, 3, 3> ref = Peanut::T(a) * a;
+        for(Peanut::Index r=0;r<3;r++){
+            for(Peanut::Index c=0;c<3;c++){
+                CHECK(gram(r, c) == Catch::Approx(ref(r, c)));
+            }
+        }
+    }
+    SECTION("Product"){
+        Peanut::Matrix<float, 3, 3> ds = s;
+        Peanut::Matrix<float, 3, 2> b{1.0f, 2.0f,
+                                      3.0f, 4.0f,
+                                      5.0f, 6.0f};
+        Peanut::Matrix<float, 3, 2> sb = s * b;
+        Peanut::Matrix<float, 3, 2> sb_ref = ds * b;
+        Peanut::Matrix<float, 3, 3> ss = s * s;
+        Peanut::Matrix<float, 3, 3> ss_ref = ds * ds;
+        for(Peanut::Index r=0;r<3;r++){
+            for(Peanut::Index c=0;c<2;c++){
+                CHECK(sb(r, c) == Catch::Approx(sb_ref(r, c)));
+            }
+            for(Peanut::Index c=0;c<3;c++){
+                CHECK(ss(r, c) == Catch::Approx(ss_ref(r, c)));
+            }
+        }
+    }
+    SECTION("Product walking the stored triangle"){
+        auto d = Peanut::Matrix<int, 6, 6>::zeros();
+        auto b = Peanut::Matrix<int, 6, 5>::zeros();
+        for(Peanut::Index r=0;r<6;r++){
+            for(Peanut::Index c=0;c<6;c++){
+                d(r, c) = static_cast<int>(r*7 + c*3) % 11 - 5;
+            }
+            for(Peanut::Index c=0;c<5;c++){
+                b(r, c) = static_cast<int>(r*5 + c) % 9 - 4;
+            }
+        }
+        Peanut::SymmetricMatrix<int, 6> big = d + Peanut::T(d);
+        Peanut::UpperTriangularMatrix<int, 6> up = d;
+        Peanut::Matrix<int, 6, 6> dbig = big;
+        Peanut::Matrix<int, 6, 6> dup = up;
+
+        Peanut::Matrix<int, 6, 5> sb = big * b;
+        Peanut::ColMajorMatrix<int, 6, 5> sb_cm = big * b;
+        Peanut::Matrix<int, 6, 5> sb_ref = dbig * b;
+        Peanut::Matrix<int, 5, 6> bs = Peanut::T(b) * big;
+        Peanut::ColMajorMatrix<int, 5, 6> bs_cm = Peanut::T(b) * big;
+        Peanut::Matrix<int, 5, 6> bs_ref = Peanut::T(b) * dbig;
+        Peanut::Matrix<int, 6, 6> ss = big * big;
+        Peanut::Matrix<int, 6, 6> ss_ref = dbig * dbig;
+        Peanut::Matrix<int, 6, 6> su = big * up;
+        Peanut::Matrix<int, 6, 6> su_ref = dbig * dup;
+        Peanut::Matrix<int, 6, 6> us = up * big;
+        Peanut::Matrix<int, 6, 6> us_ref = dup * dbig;
+        for(Peanut::Index r=0;r<6;r++){
+            for(Peanut::Index c=0;c<5;c++){
+                CHECK(sb(r, c) == sb_ref(r, c));
+                CHECK(sb_cm(r, c) == sb_ref(r, c));
+                CHECK(bs(c, r) == bs_ref(c, r));
+                CHECK(bs_cm(c, r) == bs_ref(c, r));
+            }
+            for(Peanut::Index c=0;c<6;c++){
+                CHECK(ss(r, c) == ss_ref(r, c));
+                CHECK(su(r, c) == su_ref(r, c));
+                CHECK(us(r, c) == us_ref(r, c));
+            }
+        }
+    }
+}